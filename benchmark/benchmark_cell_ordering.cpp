@@ -0,0 +1,141 @@
+#include <array>
+#include <benchmark/benchmark.h>
+#include <vector>
+
+#include <xtensor/xfixed.hpp>
+#include <xtensor/xrandom.hpp>
+
+#include <samurai/algorithm.hpp>
+#include <samurai/cell_array.hpp>
+#include <samurai/cell_list.hpp>
+#include <samurai/static_algorithm.hpp>
+
+// Compare the locality of a 2*dim+1 points stencil sweep when the cells of each
+// level are numbered in lexicographic order or by tiles along a Morton curve.
+//
+// The same comparison can be done on the demos (advection_2d, heat, ...) with
+// the --morton-ordering option, for example under `perf stat -e cache-misses`.
+
+namespace
+{
+    template <std::size_t dim>
+    auto generate_adapted_mesh(int bound, std::size_t start_level, std::size_t max_level)
+    {
+        samurai::Box<int, dim> box({-bound << start_level, -bound << start_level, -bound << start_level},
+                                   {bound << start_level, bound << start_level, bound << start_level});
+        samurai::CellArray<dim> ca;
+
+        ca[start_level] = {start_level, box};
+
+        xt::random::seed(42);
+        for (std::size_t ite = 0; ite < max_level - start_level; ++ite)
+        {
+            samurai::CellList<dim> cl;
+
+            samurai::for_each_interval(ca,
+                                       [&](std::size_t level, const auto& interval, const auto& index)
+                                       {
+                                           auto choice = xt::random::choice(xt::xtensor_fixed<bool, xt::xshape<2>>{true, false},
+                                                                            interval.size());
+                                           for (int i = interval.start, ic = 0; i < interval.end; ++i, ++ic)
+                                           {
+                                               if (choice[ic])
+                                               {
+                                                   samurai::static_nested_loop<dim - 1, 0, 2>(
+                                                       [&](auto stencil)
+                                                       {
+                                                           auto new_index = 2 * index + stencil;
+                                                           cl[level + 1][new_index].add_interval({2 * i, 2 * i + 2});
+                                                       });
+                                               }
+                                               else
+                                               {
+                                                   cl[level][index].add_point(i);
+                                               }
+                                           }
+                                       });
+
+            ca = {cl, true};
+        }
+
+        return ca;
+    }
+
+    /// Storage index of the neighbours of each cell at the same level (itself when missing)
+    template <std::size_t dim, class CA>
+    auto stencil_indices(const CA& ca)
+    {
+        std::vector<std::array<std::ptrdiff_t, 2 * dim + 1>> stencils(ca.nb_cells());
+
+        samurai::for_each_interval(ca,
+                                   [&](std::size_t level, const auto& interval, const auto& index)
+                                   {
+                                       const auto& lca = ca[level];
+                                       xt::xtensor_fixed<int, xt::xshape<dim>> coord;
+                                       for (std::size_t d = 0; d < dim - 1; ++d)
+                                       {
+                                           coord[d + 1] = index[d];
+                                       }
+                                       for (int i = interval.start; i < interval.end; ++i)
+                                       {
+                                           coord[0]         = i;
+                                           auto cell        = static_cast<std::ptrdiff_t>(interval.index + i);
+                                           auto& stencil    = stencils[static_cast<std::size_t>(cell)];
+                                           stencil[2 * dim] = cell;
+                                           for (std::size_t d = 0; d < dim; ++d)
+                                           {
+                                               for (int s = 0; s < 2; ++s)
+                                               {
+                                                   auto neighbour = coord;
+                                                   neighbour[d] += 2 * s - 1;
+                                                   auto pos = samurai::find(lca, neighbour);
+                                                   stencil[2 * d + static_cast<std::size_t>(s)] = pos == -1
+                                                                                                    ? cell
+                                                                                                    : static_cast<std::ptrdiff_t>(
+                                                                                                          lca[0][static_cast<std::size_t>(pos)].index
+                                                                                                          + neighbour[0]);
+                                               }
+                                           }
+                                       }
+                                   });
+        return stencils;
+    }
+}
+
+template <std::size_t dim, int bound, bool morton>
+void CellOrdering_stencil(benchmark::State& state)
+{
+    constexpr std::size_t min_level = 1;
+    const auto max_level            = static_cast<std::size_t>(state.range(0));
+
+    auto ca = generate_adapted_mesh<dim>(bound, min_level, max_level);
+    if constexpr (morton)
+    {
+        ca.update_index_morton();
+    }
+    const auto stencils = stencil_indices<dim>(ca);
+
+    std::vector<double> u(ca.nb_cells(), 1.);
+    std::vector<double> v(ca.nb_cells());
+    for (auto _ : state)
+    {
+        for (std::size_t cell = 0; cell < stencils.size(); ++cell)
+        {
+            double sum = 0;
+            for (auto neighbour : stencils[cell])
+            {
+                sum += u[static_cast<std::size_t>(neighbour)];
+            }
+            v[cell] = sum;
+        }
+        benchmark::DoNotOptimize(v.data());
+        benchmark::ClobberMemory();
+    }
+    state.counters["nb cells"] = static_cast<double>(ca.nb_cells());
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * stencils.size() * (2 * dim + 2) * sizeof(double)));
+}
+
+BENCHMARK_TEMPLATE(CellOrdering_stencil, 2, 8, false)->DenseRange(8, 11, 1);
+BENCHMARK_TEMPLATE(CellOrdering_stencil, 2, 8, true)->DenseRange(8, 11, 1);
+BENCHMARK_TEMPLATE(CellOrdering_stencil, 3, 1, false)->DenseRange(5, 7, 1);
+BENCHMARK_TEMPLATE(CellOrdering_stencil, 3, 1, true)->DenseRange(5, 7, 1);
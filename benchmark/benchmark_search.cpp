@@ -89,6 +89,50 @@ class MyFixture : public ::benchmark::Fixture
         state.counters["found"]    = static_cast<double>(found) / state.iterations();
     }
 
+    // Look up every cell of the mesh, row after row, as done by the field accessors
+    template <bool use_cursor>
+    void bench_rows(benchmark::State& state)
+    {
+        std::size_t found = 0;
+        for (auto _ : state)
+        {
+            for (std::size_t level = min_level; level <= max_level; ++level)
+            {
+                const auto& lca = mesh[level];
+                auto cursor     = samurai::make_row_cursor(lca);
+                samurai::for_each_interval(lca,
+                                           [&](std::size_t, const auto& interval, const auto& index)
+                                           {
+                                               xt::xtensor_fixed<int, xt::xshape<dim>> coord;
+                                               for (std::size_t d = 0; d < dim - 1; ++d)
+                                               {
+                                                   coord[d + 1] = index[d];
+                                               }
+                                               for (int i = interval.start; i < interval.end; ++i)
+                                               {
+                                                   coord[0] = i;
+                                                   std::ptrdiff_t out;
+                                                   if constexpr (use_cursor)
+                                                   {
+                                                       out = cursor.find(coord);
+                                                   }
+                                                   else
+                                                   {
+                                                       out = samurai::find(lca, coord);
+                                                   }
+                                                   benchmark::DoNotOptimize(out);
+                                                   if (out != -1)
+                                                   {
+                                                       found++;
+                                                   }
+                                               }
+                                           });
+            }
+        }
+        state.counters["nb cells"] = mesh.nb_cells();
+        state.counters["found"]    = static_cast<double>(found) / state.iterations();
+    }
+
     samurai::CellArray<dim_> mesh;
 };
 
@@ -116,3 +160,31 @@ BENCHMARK_TEMPLATE_DEFINE_F(MyFixture, Search_3D, 3, 1)(benchmark::State& state)
 }
 
 BENCHMARK_REGISTER_F(MyFixture, Search_3D)->DenseRange(1, 10, 1);
+
+BENCHMARK_TEMPLATE_DEFINE_F(MyFixture, RowSearch_find_2D, 2, 10)(benchmark::State& state)
+{
+    bench_rows<false>(state);
+}
+
+BENCHMARK_REGISTER_F(MyFixture, RowSearch_find_2D);
+
+BENCHMARK_TEMPLATE_DEFINE_F(MyFixture, RowSearch_cursor_2D, 2, 10)(benchmark::State& state)
+{
+    bench_rows<true>(state);
+}
+
+BENCHMARK_REGISTER_F(MyFixture, RowSearch_cursor_2D);
+
+BENCHMARK_TEMPLATE_DEFINE_F(MyFixture, RowSearch_find_3D, 3, 1)(benchmark::State& state)
+{
+    bench_rows<false>(state);
+}
+
+BENCHMARK_REGISTER_F(MyFixture, RowSearch_find_3D);
+
+BENCHMARK_TEMPLATE_DEFINE_F(MyFixture, RowSearch_cursor_3D, 3, 1)(benchmark::State& state)
+{
+    bench_rows<true>(state);
+}
+
+BENCHMARK_REGISTER_F(MyFixture, RowSearch_cursor_3D);
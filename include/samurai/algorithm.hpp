@@ -3,16 +3,19 @@
 
 #pragma once
 
-#ifdef SAMURAI_WITH_OPENMP
-#include <omp.h>
-#endif
+#include <algorithm>
+#include <iterator>
 #include <type_traits>
+#include <vector>
 
 #include <xtensor/xfixed.hpp>
 #include <xtensor/xview.hpp>
 
 #include "cell.hpp"
+#include "cell_batch.hpp"
 #include "mesh_holder.hpp"
+#include "parallel.hpp"
+#include "subset/utils.hpp"
 
 using namespace xt::placeholders;
 
@@ -171,21 +174,21 @@ namespace samurai
             });
     }
 
+    /**
+     * The positions along the last dimension of the set are split into chunks
+     * traversed concurrently (see apply with Run::Parallel): f must only write
+     * to the cells of the interval it is given.
+     */
     template <class MeshIntervalType, class SetType, class Func>
     inline void parallel_for_each_meshinterval(SetType& set, Func&& f)
     {
-#pragma omp parallel
-#pragma omp single nowait
-        set(
-            [&](const auto& i, const auto& index)
+        set.template apply_op<Run::Parallel>(
+            [&](std::size_t level, const auto& i, const auto& index)
             {
-#pragma omp task
-                {
-                    MeshIntervalType mesh_interval(set.level());
-                    mesh_interval.i     = i;
-                    mesh_interval.index = index;
-                    f(mesh_interval);
-                }
+                MeshIntervalType mesh_interval(level);
+                mesh_interval.i     = i;
+                mesh_interval.index = index;
+                f(mesh_interval);
             });
     }
 
@@ -229,30 +232,155 @@ namespace samurai
         }
     }
 
+    namespace detail
+    {
+        /**
+         * Positions in lca[0] splitting the x-intervals into nb_chunks chunks
+         * of about the same number of cells.
+         */
+        template <class LCA>
+        std::vector<std::size_t> cell_chunks(const LCA& lca, std::size_t nb_chunks)
+        {
+            const auto& x_intervals    = lca[0];
+            const std::size_t nb_cells = lca.nb_cells();
+
+            std::vector<std::size_t> bounds;
+            bounds.reserve(nb_chunks + 1);
+            bounds.push_back(0);
+
+            std::size_t cells = 0;
+            for (std::size_t k = 0; k + 1 < x_intervals.size() && bounds.size() < nb_chunks; ++k)
+            {
+                cells += static_cast<std::size_t>(x_intervals[k].size());
+                if (cells * nb_chunks >= bounds.size() * nb_cells)
+                {
+                    bounds.push_back(k + 1);
+                }
+            }
+            bounds.push_back(x_intervals.size());
+            return bounds;
+        }
+    }
+
+    /**
+     * The x-intervals are split into one chunk of about the same number of
+     * cells per thread, each chunk being traversed from an iterator placed by
+     * bisection. The chunk c is always given to the thread c, as when the
+     * fields are first touched (see detail::first_touch). Nested in a parallel
+     * region, or without parallel backend, the traversal is sequential.
+     */
     template <std::size_t dim, class TInterval, class Func>
     inline void parallel_for_each_cell(const LevelCellArray<dim, TInterval>& lca, Func&& f)
     {
+#ifdef SAMURAI_WITH_PARALLEL
         using cell_t        = Cell<dim, TInterval>;
         using index_value_t = typename cell_t::value_t;
 
-#pragma omp parallel
-#pragma omp single nowait
+        if (!lca.empty() && !parallel::in_parallel())
         {
-            for (auto it = lca.cbegin(); it != lca.cend(); ++it)
-            {
-#pragma omp task
-                for (index_value_t i = it->start; i < it->end; ++i)
+            const auto bounds = detail::cell_chunks(lca, parallel::max_threads());
+
+            parallel::for_each_thread(
+                [&](std::size_t thread, std::size_t nb_threads)
                 {
                     typename cell_t::indices_t index;
-                    for (std::size_t d = 0; d < dim - 1; ++d)
+
+                    for (std::size_t c = thread; c + 1 < bounds.size(); c += nb_threads)
                     {
-                        index[d + 1] = it.index()[d];
+                        auto it = lca.citerator_at(bounds[c]);
+                        for (std::size_t k = bounds[c]; k < bounds[c + 1]; ++k, ++it)
+                        {
+                            for (std::size_t d = 0; d < dim - 1; ++d)
+                            {
+                                index[d + 1] = it.index()[d];
+                            }
+                            for (index_value_t i = it->start; i < it->end; ++i)
+                            {
+                                index[0] = i;
+                                cell_t cell{lca.origin_point(), lca.scaling_factor(), lca.level(), index, it->index + i};
+                                f(cell);
+                            }
+                        }
                     }
-                    index[0] = i;
-                    cell_t cell{lca.origin_point(), lca.scaling_factor(), lca.level(), index, it->index + i};
-                    f(cell);
-                }
+                });
+            return;
+        }
+#endif
+        for_each_cell(lca, std::forward<Func>(f));
+    }
+
+    namespace detail
+    {
+        /**
+         * Call f(first, last) for the ranges [first, last[ of storage indices
+         * of the cells of lca, the intervals adjacent in the storage being
+         * merged. Each chunk of parallel_for_each_cell is given to the thread
+         * which traverses it.
+         */
+        template <std::size_t dim, class TInterval, class Func>
+        void parallel_for_each_index_range(const LevelCellArray<dim, TInterval>& lca, Func&& f)
+        {
+            using index_t = typename TInterval::index_t;
+
+            if (lca.empty())
+            {
+                return;
             }
+
+            const auto& x_intervals = lca[0];
+            const auto bounds       = cell_chunks(lca, parallel::max_threads());
+            parallel::for_each_thread(
+                [&](std::size_t thread, std::size_t nb_threads)
+                {
+                    for (std::size_t c = thread; c + 1 < bounds.size(); c += nb_threads)
+                    {
+                        if (bounds[c] == bounds[c + 1])
+                        {
+                            continue;
+                        }
+                        index_t first = x_intervals[bounds[c]].index + x_intervals[bounds[c]].start;
+                        index_t last  = first;
+                        for (std::size_t k = bounds[c]; k < bounds[c + 1]; ++k)
+                        {
+                            const auto& i = x_intervals[k];
+                            if (i.index + i.start != last)
+                            {
+                                f(first, last);
+                                first = i.index + i.start;
+                            }
+                            last = i.index + i.end;
+                        }
+                        f(first, last);
+                    }
+                });
+        }
+
+        template <std::size_t dim, class TInterval, std::size_t max_size, class Func>
+        void parallel_for_each_index_range(const CellArray<dim, TInterval, max_size>& ca, Func&& f)
+        {
+            for_each_level(ca,
+                           [&](std::size_t level)
+                           {
+                               parallel_for_each_index_range(ca[level], f);
+                           });
+        }
+
+        /**
+         * Set the values of the cells of ca in storage, each chunk of
+         * parallel_for_each_cell being set by the thread which traverses it:
+         * the memory pages touched first by a thread are placed on its NUMA
+         * node.
+         */
+        template <class CA, class Storage, class value_t>
+        void parallel_fill(const CA& ca, Storage& storage, value_t value)
+        {
+            using size_type = typename Storage::size_type;
+
+            parallel_for_each_index_range(ca,
+                                          [&](auto first, auto last)
+                                          {
+                                              storage.fill(static_cast<size_type>(first), static_cast<size_type>(last), value);
+                                          });
         }
     }
 
@@ -328,6 +456,91 @@ namespace samurai
         for_each_cell(mesh.get(), std::forward<Func>(f));
     }
 
+    ////////////////////////////////////////
+    // for_each_cell_batch implementation //
+    ////////////////////////////////////////
+
+    /**
+     * Call f with the cells of each x-interval of the array at once, as a
+     * CellBatch giving the storage indices and the centers of the cells.
+     *
+     * With run_type = Run::Parallel, the x-intervals are split as in
+     * parallel_for_each_cell and each thread has its own batch.
+     */
+    template <Run run_type, std::size_t dim, class TInterval, class Func>
+    inline void for_each_cell_batch(const LevelCellArray<dim, TInterval>& lca, Func&& f)
+    {
+        if (lca.empty())
+        {
+            return;
+        }
+
+#ifdef SAMURAI_WITH_PARALLEL
+        if constexpr (run_type == Run::Parallel)
+        {
+            if (!parallel::in_parallel())
+            {
+                const auto bounds = detail::cell_chunks(lca, parallel::max_threads());
+
+                parallel::for_each_thread(
+                    [&](std::size_t thread, std::size_t nb_threads)
+                    {
+                        detail::CellBatchBuffer<dim, TInterval> buffer;
+
+                        for (std::size_t c = thread; c + 1 < bounds.size(); c += nb_threads)
+                        {
+                            auto it = lca.citerator_at(bounds[c]);
+                            for (std::size_t k = bounds[c]; k < bounds[c + 1]; ++k, ++it)
+                            {
+                                f(buffer.fill(lca, *it, it.index()));
+                            }
+                        }
+                    });
+                return;
+            }
+        }
+#endif
+        detail::CellBatchBuffer<dim, TInterval> buffer;
+        for (auto it = lca.cbegin(); it != lca.cend(); ++it)
+        {
+            f(buffer.fill(lca, *it, it.index()));
+        }
+    }
+
+    template <std::size_t dim, class TInterval, class Func>
+    inline void for_each_cell_batch(const LevelCellArray<dim, TInterval>& lca, Func&& f)
+    {
+        for_each_cell_batch<Run::Sequential>(lca, std::forward<Func>(f));
+    }
+
+    template <Run run_type, std::size_t dim, class TInterval, std::size_t max_size, class Func>
+    inline void for_each_cell_batch(const CellArray<dim, TInterval, max_size>& ca, Func&& f)
+    {
+        for (std::size_t level = ca.min_level(); level <= ca.max_level(); ++level)
+        {
+            for_each_cell_batch<run_type>(ca[level], std::forward<Func>(f));
+        }
+    }
+
+    template <std::size_t dim, class TInterval, std::size_t max_size, class Func>
+    inline void for_each_cell_batch(const CellArray<dim, TInterval, max_size>& ca, Func&& f)
+    {
+        for_each_cell_batch<Run::Sequential>(ca, std::forward<Func>(f));
+    }
+
+    template <Run run_type, class Mesh, class Func>
+    inline void for_each_cell_batch(const Mesh& mesh, Func&& f)
+    {
+        using mesh_id_t = typename Mesh::mesh_id_t;
+        for_each_cell_batch<run_type>(mesh[mesh_id_t::cells], std::forward<Func>(f));
+    }
+
+    template <class Mesh, class Func>
+    inline void for_each_cell_batch(const Mesh& mesh, Func&& f)
+    {
+        for_each_cell_batch<Run::Sequential>(mesh, std::forward<Func>(f));
+    }
+
     template <class Mesh, class coord_type, class Func>
     inline void for_each_cell(const Mesh& mesh, std::size_t level, const typename Mesh::interval_t& i, const coord_type& index, Func&& f)
     {
@@ -367,50 +580,71 @@ namespace samurai
 
     namespace detail
     {
-        // template <class ForwardIt, class T>
-        // auto interval_search(ForwardIt first, ForwardIt last, const T& value)
-        // {
-        //     auto comp = [](const auto& interval, auto v)
-        //     {
-        //         return interval.end < v;
-        //     };
-
-        //     auto result = std::lower_bound(first, last, value, comp);
-
-        //     if (!(result == last) && !(comp(*result, value)))
-        //     {
-        //         if (result->contains(value))
-        //         {
-        //             return static_cast<int>(std::distance(first, result));
-        //         }
-        //     }
-        //     return -1;
-        // }
-
-        template <class ForwardIt, class T>
-        inline auto interval_search(ForwardIt first, ForwardIt last, const T& value)
-        {
-            for (int dist = 0; first != last; ++first, ++dist)
+        /**
+         * Return the position in [first, last[ of the interval containing value,
+         * or -1 if there is none.
+         *
+         * The intervals of a row are sorted and disjoint: small ranges are
+         * scanned linearly, larger ones are searched by bisection.
+         */
+        template <class RandomIt, class T>
+        inline auto interval_search(RandomIt first, RandomIt last, const T& value) -> std::ptrdiff_t
+        {
+            static constexpr std::ptrdiff_t linear_search_size = 8;
+
+            if (std::distance(first, last) <= linear_search_size)
             {
-                if (first->contains(value))
+                for (std::ptrdiff_t dist = 0; first != last; ++first, ++dist)
                 {
-                    return dist;
+                    if (first->contains(value))
+                    {
+                        return dist;
+                    }
                 }
+                return -1;
             }
-            return -1;
+
+            auto it = lower_bound_interval(first, last, value);
+            return (it != last && it->contains(value)) ? std::distance(first, it) : -1;
         }
 
-        // template <class ForwardIt, class T>
-        // inline auto interval_search(ForwardIt first, ForwardIt last, const T& value)
-        // {
-        //     auto it = std::find_if(first,
-        //                            last,
-        //                            [value](const auto& e)
-        //                            {
-        //                                return e.contains(value);
-        //                            });
-        //     return (it == last) ? -1 : static_cast<int>(std::distance(first, it));
-        // }
+        /**
+         * Same as interval_search but starting from the position hint in [first, last[.
+         *
+         * When value lies after hint, the range is explored forward with steps
+         * of increasing size (galloping) before being bisected, so that
+         * successive searches of increasing values are in amortized O(1).
+         */
+        template <class RandomIt, class T>
+        inline auto interval_search(RandomIt first, RandomIt last, RandomIt hint, const T& value) -> std::ptrdiff_t
+        {
+            if (hint == last)
+            {
+                return interval_search(first, last, value);
+            }
+            if (hint->contains(value))
+            {
+                return std::distance(first, hint);
+            }
+            if (value < hint->start)
+            {
+                return interval_search(first, hint, value);
+            }
+
+            const auto remaining = std::distance(hint, last);
+            std::ptrdiff_t prev  = 0;
+            std::ptrdiff_t step  = 1;
+            while (step < remaining && (hint + step)->end <= value)
+            {
+                prev = step;
+                step *= 2;
+            }
+
+            auto lower = hint + prev + 1;
+            auto upper = (step < remaining) ? hint + step + 1 : last;
+            auto it    = lower_bound_interval(lower, upper, value);
+            return (it != upper && it->contains(value)) ? std::distance(first, it) : -1;
+        }
 
         template <std::size_t dim, class TInterval, class index_t = typename TInterval::index_t, class coord_index_t = typename TInterval::coord_index_t>
         inline auto find_impl(const LevelCellArray<dim, TInterval>& lca,
@@ -464,19 +698,212 @@ namespace samurai
         return detail::find_impl(lca, 0, lca[dim - 1].size(), coord, std::integral_constant<std::size_t, dim - 1>{});
     }
 
-    template <std::size_t dim, class TInterval, class coord_index_t = typename TInterval::coord_index_t, class index_t = typename TInterval::index_t>
-    inline auto
-    find_on_dim(const LevelCellArray<dim, TInterval>& lca, std::size_t d, std::size_t start_index, std::size_t end_index, coord_index_t coord)
+    /// Search along the dimension d of a LevelCellArray or of a LevelCellArrayView.
+    template <class LCA, class coord_index_t = typename LCA::interval_t::coord_index_t, class index_t = typename LCA::interval_t::index_t>
+    inline auto find_on_dim(const LCA& lca, std::size_t d, std::size_t start_index, std::size_t end_index, coord_index_t coord)
     {
-        using lca_t        = const LevelCellArray<dim, TInterval>;
-        using diff_t       = typename lca_t::const_iterator::difference_type;
-        index_t find_index = detail::interval_search(lca[d].cbegin() + static_cast<diff_t>(start_index),
-                                                     lca[d].cbegin() + static_cast<diff_t>(end_index),
+        index_t find_index = detail::interval_search(lca[d].begin() + static_cast<std::ptrdiff_t>(start_index),
+                                                     lca[d].begin() + static_cast<std::ptrdiff_t>(end_index),
                                                      coord);
 
         return (find_index != -1) ? static_cast<std::size_t>(find_index) + start_index : std::numeric_limits<std::size_t>::max();
     }
 
+    //----------------------------------//
+    // Stateful lookup along the x-rows //
+    //----------------------------------//
+
+    /** @class RowCursor
+     *  @brief Lookup object remembering the last row and interval found in a LevelCellArray.
+     *
+     * The y/z part of the search is only done when the requested row changes,
+     * and the x part starts from the last interval found. Successive lookups
+     * along a row (increasing x with the same y/z) are thus in amortized O(1).
+     *
+     * A cursor must not be shared between threads and is invalidated
+     * by any modification of the LevelCellArray.
+     *
+     * @tparam LCA The LevelCellArray type.
+     */
+    template <class LCA>
+    class RowCursor
+    {
+      public:
+
+        static constexpr std::size_t dim = LCA::dim;
+        using interval_t                 = typename LCA::interval_t;
+        using value_t                    = typename interval_t::value_t;
+        using index_t                    = typename interval_t::index_t;
+        using coord_t                    = xt::xtensor_fixed<value_t, xt::xshape<dim - 1>>;
+        using all_coord_t                = xt::xtensor_fixed<value_t, xt::xshape<dim>>;
+
+        explicit RowCursor(const LCA& lca);
+
+        template <class E>
+        index_t find(value_t i, const E& index);
+        index_t find(const all_coord_t& coord);
+
+        template <class E>
+        const interval_t& get_interval(value_t i, const E& index);
+
+        template <class E>
+        index_t get_index(value_t i, const E& index);
+
+        void reset();
+
+      private:
+
+        template <class E>
+        bool is_current_row(const E& index) const;
+
+        template <class E>
+        void move_to_row(const E& index);
+
+        const LCA& m_lca;
+        coord_t m_row;
+        bool m_has_row         = false;
+        std::size_t m_first    = 0; ///< First interval of the current row in lca[0]
+        std::size_t m_last     = 0; ///< Last interval + 1 of the current row in lca[0]
+        std::size_t m_position = 0; ///< Last interval found in lca[0]
+    };
+
+    template <class LCA>
+    inline RowCursor<LCA>::RowCursor(const LCA& lca)
+        : m_lca(lca)
+    {
+    }
+
+    /**
+     * Return the position in lca[0] of the interval containing the cell (i, index),
+     * or -1 if there is none.
+     */
+    template <class LCA>
+    template <class E>
+    inline auto RowCursor<LCA>::find(value_t i, const E& index) -> index_t
+    {
+        if (!is_current_row(index))
+        {
+            move_to_row(index);
+        }
+
+        using diff_t = typename std::vector<interval_t>::const_iterator::difference_type;
+        auto first   = m_lca[0].cbegin() + static_cast<diff_t>(m_first);
+        auto last    = m_lca[0].cbegin() + static_cast<diff_t>(m_last);
+        auto hint    = m_lca[0].cbegin() + static_cast<diff_t>(m_position);
+
+        auto find_index = detail::interval_search(first, last, hint, i);
+        if (find_index == -1)
+        {
+            return -1;
+        }
+        m_position = m_first + static_cast<std::size_t>(find_index);
+        return static_cast<index_t>(m_position);
+    }
+
+    template <class LCA>
+    inline auto RowCursor<LCA>::find(const all_coord_t& coord) -> index_t
+    {
+        coord_t index;
+        for (std::size_t d = 0; d < dim - 1; ++d)
+        {
+            index[d] = coord[d + 1];
+        }
+        return find(coord[0], index);
+    }
+
+    template <class LCA>
+    template <class E>
+    inline auto RowCursor<LCA>::get_interval(value_t i, const E& index) -> const interval_t&
+    {
+        auto offset = find(i, index);
+#ifndef NDEBUG
+        if (offset < 0)
+        {
+            std::cerr << "Error: Interval not found: level " << m_lca.level() << ", i = " << i << ", index = ";
+            for (std::size_t d = 0; d < dim - 1; ++d)
+            {
+                std::cerr << index[d] << " ";
+            }
+            std::cerr << std::endl;
+        }
+#endif
+        return m_lca[0][static_cast<std::size_t>(offset)];
+    }
+
+    template <class LCA>
+    template <class E>
+    inline auto RowCursor<LCA>::get_index(value_t i, const E& index) -> index_t
+    {
+        return get_interval(i, index).index + i;
+    }
+
+    /**
+     * Forget the current row (required if the LevelCellArray has been modified).
+     */
+    template <class LCA>
+    inline void RowCursor<LCA>::reset()
+    {
+        m_has_row  = false;
+        m_first    = 0;
+        m_last     = 0;
+        m_position = 0;
+    }
+
+    template <class LCA>
+    template <class E>
+    inline bool RowCursor<LCA>::is_current_row(const E& index) const
+    {
+        if (!m_has_row)
+        {
+            return false;
+        }
+        for (std::size_t d = 0; d < dim - 1; ++d)
+        {
+            if (m_row[d] != index[d])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <class LCA>
+    template <class E>
+    inline void RowCursor<LCA>::move_to_row(const E& index)
+    {
+        for (std::size_t d = 0; d < dim - 1; ++d)
+        {
+            m_row[d] = index[d];
+        }
+        m_has_row = true;
+
+        std::size_t start = 0;
+        std::size_t end   = m_lca[dim - 1].size();
+        for (std::size_t d = dim - 1; d > 0; --d)
+        {
+            auto j = find_on_dim(m_lca, d, start, end, m_row[d - 1]);
+            if (j == std::numeric_limits<std::size_t>::max())
+            {
+                // empty row: every search will fail until the row changes
+                start = 0;
+                end   = 0;
+                break;
+            }
+            auto io = static_cast<std::size_t>(m_lca[d][j].index + m_row[d - 1]);
+            start   = m_lca.offsets(d)[io];
+            end     = m_lca.offsets(d)[io + 1];
+        }
+        m_first    = start;
+        m_last     = end;
+        m_position = start;
+    }
+
+    template <class LCA>
+    inline auto make_row_cursor(const LCA& lca)
+    {
+        return RowCursor<LCA>(lca);
+    }
+
     //----------------------------------------//
     // Find a cell from Cartesian coordinates //
     //----------------------------------------//
@@ -4,6 +4,8 @@
 #pragma once
 
 #include <algorithm>
+#include <type_traits>
+#include <utility>
 
 #include <xtensor/xfixed.hpp>
 
@@ -409,7 +411,11 @@ namespace samurai
             update_ghost_periodic(level, field, other_fields...);
             update_ghost_subdomains(level, field, other_fields...);
 
-            auto set_at_levelm1 = intersection(mesh[mesh_id_t::reference][level], mesh[mesh_id_t::proj_cells][level - 1]).on(level - 1);
+            // the sets only depend on the mesh: they are evaluated once per mesh
+            const auto& set_at_levelm1 = mesh.subset_plan(
+                "update_ghost_mr/projection",
+                level - 1,
+                intersection(mesh[mesh_id_t::reference][level], mesh[mesh_id_t::proj_cells][level - 1]).on(level - 1));
             set_at_levelm1.apply_op(variadic_projection(field, other_fields...));
 
             update_outer_ghosts(level - 1, field, other_fields...);
@@ -428,7 +434,9 @@ namespace samurai
         {
             auto pred_ghosts = difference(mesh[mesh_id_t::all_cells][level],
                                           union_(mesh[mesh_id_t::cells][level], mesh[mesh_id_t::proj_cells][level]));
-            auto expr        = intersection(pred_ghosts, mesh.subdomain(), mesh[mesh_id_t::all_cells][level - 1]).on(level);
+            const auto& expr = mesh.subset_plan("update_ghost_mr/prediction",
+                                                level,
+                                                intersection(pred_ghosts, mesh.subdomain(), mesh[mesh_id_t::all_cells][level - 1]).on(level));
 
             expr.apply_op(variadic_prediction<pred_order, false>(field, other_fields...));
             update_ghost_periodic(level, field, other_fields...);
@@ -531,12 +539,15 @@ namespace samurai
                                                   neighbour.mesh[mesh_id_t::reference][level],
                                                   mesh.subdomain())
                                          .on(level);
+                auto subdomain_corners = outer_subdomain_corner<true>(level, field, neighbour);
+
+                // the buffer is allocated once before the packing
+                to_send[i_neigh].reserve((out_interface.count_cells() + subdomain_corners.nb_cells()) * Field::n_comp);
                 out_interface(
                     [&](const auto& i, const auto& index)
                     {
                         std::copy(field(level, i, index).begin(), field(level, i, index).end(), std::back_inserter(to_send[i_neigh]));
                     });
-                auto subdomain_corners = outer_subdomain_corner<true>(level, field, neighbour);
                 for_each_interval(
                     subdomain_corners,
                     [&](const auto, const auto& i, const auto& index)
@@ -1198,6 +1209,35 @@ namespace samurai
 
     namespace detail
     {
+        /**
+         * Copy the values of src to dest on the cells of set, at level, row
+         * by row: the x-intervals holding a row in dest and src are found by
+         * cursors moving along the row, and each interval of the set is
+         * copied as contiguous ranges of the arrays.
+         */
+        template <class Set, class Field>
+        void copy_rows(std::size_t level, Set&& set, Field& dest, const Field& src)
+        {
+            using mesh_id_t = typename Field::mesh_t::mesh_id_t;
+            using size_type = typename std::decay_t<decltype(dest.m_storage)>::size_type;
+
+            auto dest_cursor = make_row_cursor(dest.mesh()[mesh_id_t::reference][level]);
+            auto src_cursor  = make_row_cursor(src.mesh()[mesh_id_t::reference][level]);
+            apply_rows(std::forward<Set>(set),
+                       [&](const auto& row, const auto& index)
+                       {
+                           for (const auto& interval : row)
+                           {
+                               const auto first     = dest_cursor.get_index(interval.start, index);
+                               const auto src_first = src_cursor.get_index(interval.start, index);
+                               dest.m_storage.copy(static_cast<size_type>(first),
+                                                   static_cast<size_type>(first + interval.size()),
+                                                   src.m_storage,
+                                                   static_cast<size_type>(src_first));
+                           }
+                       });
+        }
+
         template <class Mesh, class Field>
         void update_fields(Mesh& new_mesh, Field& field)
         {
@@ -1219,7 +1259,7 @@ namespace samurai
             for (std::size_t level = min_level; level <= max_level; ++level)
             {
                 auto set = intersection(mesh[mesh_id_t::reference][level], new_mesh[mesh_id_t::cells][level]);
-                set.apply_op(copy(new_field, field));
+                copy_rows(level, set, new_field, field);
             }
 
             for (std::size_t level = min_level + 1; level <= max_level; ++level)
@@ -1272,7 +1312,7 @@ namespace samurai
 
         cl_type cl;
 
-        for_each_interval(mesh[mesh_id_t::cells],
+        for_each_interval(std::as_const(mesh[mesh_id_t::cells]),
                           [&](std::size_t level, const auto& interval, const auto& index)
                           {
                               auto itag = static_cast<size_type>(interval.start + interval.index);
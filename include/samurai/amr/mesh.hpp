@@ -114,7 +114,7 @@ namespace samurai::amr
     inline void Mesh<Config>::update_sub_mesh_impl()
     {
         cl_type cl;
-        for_each_interval(this->cells()[mesh_id_t::cells],
+        for_each_interval(std::as_const(this->cells()[mesh_id_t::cells]),
                           [&](std::size_t level, const auto& interval, const auto& index_yz)
                           {
                               lcl_type& lcl = cl[level];
@@ -139,14 +139,7 @@ namespace samurai::amr
                                    this->cells()[mesh_id_t::cells][level - 1])
                             .on(level);
 
-            lcl_type lcl{level};
-            expr(
-                [&](const auto& interval, const auto& index_yz)
-                {
-                    lcl[index_yz].add_interval({interval.start, interval.end});
-                });
-
-            this->cells()[mesh_id_t::proj_cells][level] = {lcl};
+            this->cells()[mesh_id_t::proj_cells][level] = lca_type(expr);
         }
 
         // construction of prediction cells
@@ -156,14 +149,7 @@ namespace samurai::amr
                                                 union_(this->get_union()[level], this->cells()[mesh_id_t::cells][level])),
                                      self(this->domain()).on(level));
 
-            lcl_type lcl{level};
-            expr(
-                [&](const auto& interval, const auto& index_yz)
-                {
-                    lcl[index_yz].add_interval(interval);
-                });
-
-            this->cells()[mesh_id_t::pred_cells][level] = {lcl};
+            this->cells()[mesh_id_t::pred_cells][level] = lca_type(expr);
         }
 
         for (std::size_t level = min_level; level <= max_level; ++level)
@@ -188,15 +174,8 @@ namespace samurai::amr
 
         for (std::size_t level = min_level; level <= max_level; ++level)
         {
-            lcl_type lcl{level};
-            auto expr = union_(this->cells()[mesh_id_t::cells_and_ghosts][level], this->cells()[mesh_id_t::proj_cells][level]);
-            expr(
-                [&](const auto& interval, const auto& index_yz)
-                {
-                    lcl[index_yz].add_interval(interval);
-                });
-
-            this->cells()[mesh_id_t::all_cells][level] = {lcl};
+            this->cells()[mesh_id_t::all_cells][level] = lca_type(
+                union_(this->cells()[mesh_id_t::cells_and_ghosts][level], this->cells()[mesh_id_t::proj_cells][level]));
         }
     }
 }
@@ -12,8 +12,10 @@ namespace samurai
 #ifdef SAMURAI_WITH_MPI
         static bool dont_redirect_output = false;
 #endif
-        static bool enable_max_level_flux = false;
-        static bool refine_boundary       = false;
+        static bool enable_max_level_flux  = false;
+        static bool refine_boundary        = false;
+        static bool morton_ordering        = false;
+        static std::size_t field_pool_size = 8;
     }
 
     inline void read_samurai_arguments(CLI::App& app, int& argc, char**& argv)
@@ -28,6 +30,14 @@ namespace samurai
             ->capture_default_str()
             ->group("SAMURAI");
         app.add_flag("--refine-boundary", args::refine_boundary, "Keep the boundary refined at max_level")->capture_default_str()->group("SAMURAI");
+        app.add_flag("--morton-ordering", args::morton_ordering, "Number the cells of each level by tiles along a Morton curve")
+            ->capture_default_str()
+            ->group("SAMURAI");
+        app.add_option("--field-pool-size",
+                       args::field_pool_size,
+                       "Maximal number of arrays of the size of the largest field in the cache of the field arrays (0 to disable it)")
+            ->capture_default_str()
+            ->group("SAMURAI");
         app.allow_extras();
         app.set_help_flag("", ""); // deactivate --help option
         try
@@ -89,7 +89,8 @@ namespace samurai
         using const_reverse_iterator = CellArray_reverse_iterator<const_iterator>;
 
         CellArray();
-        CellArray(const cl_type& cl, bool with_update_index = true);
+        template <class TLevelCellList>
+        CellArray(const CellList<dim, TInterval, max_size, TLevelCellList>& cl, bool with_update_index = true);
 
         const lca_type& operator[](std::size_t i) const;
         lca_type& operator[](std::size_t i);
@@ -124,6 +125,8 @@ namespace samurai
 
         bool empty() const;
 
+        std::size_t hash() const;
+
         std::size_t max_level() const;
         std::size_t min_level() const;
 
@@ -134,6 +137,7 @@ namespace samurai
         double cell_length(std::size_t level) const;
 
         void update_index();
+        void update_index_morton();
 
         void to_stream(std::ostream& os) const;
 
@@ -253,12 +257,14 @@ namespace samurai
     /**
      * Construction of a CellArray from a CellList
      *
-     * @param cl The cell list.
+     * @param cl The cell list (filled with LevelCellList or FlatLevelCellList).
      * @parma with_update_index A boolean indicating if the index of the
      * x-intervals must be computed.
      */
     template <std::size_t dim_, class TInterval, std::size_t max_size_>
-    inline CellArray<dim_, TInterval, max_size_>::CellArray(const cl_type& cl, bool with_update_index)
+    template <class TLevelCellList>
+    inline CellArray<dim_, TInterval, max_size_>::CellArray(const CellList<dim, TInterval, max_size, TLevelCellList>& cl,
+                                                            bool with_update_index)
     {
         for (std::size_t level = 0; level <= max_size; ++level)
         {
@@ -407,6 +413,24 @@ namespace samurai
         return m_cells[level].nb_cells();
     }
 
+    /**
+     * Return a hash of the cells of all the levels, whatever the indices of
+     * the x-intervals (see LevelCellArray::hash).
+     */
+    template <std::size_t dim_, class TInterval, std::size_t max_size_>
+    inline std::size_t CellArray<dim_, TInterval, max_size_>::hash() const
+    {
+        std::size_t seed = 0;
+        for (std::size_t level = 0; level <= max_size; ++level)
+        {
+            if (!m_cells[level].empty())
+            {
+                ::hash_combine(seed, m_cells[level].hash());
+            }
+        }
+        return seed;
+    }
+
     /**
      * Return the maximum level where the array entry is not empty.
      */
@@ -483,12 +507,32 @@ namespace samurai
     inline void CellArray<dim_, TInterval, max_size_>::update_index()
     {
         std::size_t acc_size = 0;
-        for_each_interval(*this,
-                          [&](auto, auto& interval, auto)
-                          {
-                              interval.index = safe_subs<index_t>(acc_size, interval.start);
-                              acc_size += interval.size();
-                          });
+        for (std::size_t level = min_level(); level <= max_level(); ++level)
+        {
+            m_cells[level].update_index(
+                [&](const auto& interval, const auto&)
+                {
+                    auto index = safe_subs<index_t>(acc_size, interval.start);
+                    acc_size += interval.size();
+                    return index;
+                });
+        }
+        check_index_capacity<index_t>(acc_size, max_level());
+    }
+
+    /**
+     * Same as update_index but the intervals of each level are numbered by
+     * tiles along a Morton curve instead of the lexicographic order (see
+     * LevelCellArray::update_index_morton).
+     */
+    template <std::size_t dim_, class TInterval, std::size_t max_size_>
+    inline void CellArray<dim_, TInterval, max_size_>::update_index_morton()
+    {
+        std::size_t acc_size = 0;
+        for (std::size_t level = 0; level <= max_size; ++level)
+        {
+            acc_size = m_cells[level].update_index_morton(acc_size);
+        }
     }
 
     template <std::size_t dim_, class TInterval, std::size_t max_size_>
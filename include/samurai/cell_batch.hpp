@@ -0,0 +1,108 @@
+// Copyright 2018-2025 the samurai's authors
+// SPDX-License-Identifier:  BSD-3-Clause
+
+#pragma once
+
+#include <array>
+#include <span>
+#include <vector>
+
+namespace samurai
+{
+    /** @class CellBatch
+     *  @brief The cells of an x-interval, given at once by for_each_cell_batch.
+     *
+     * The storage indices and the coordinates of the centers of the cells are
+     * given as contiguous arrays, so that the loops over a batch can be
+     * vectorized by the compiler:
+     *
+     * @code
+     * for (std::size_t k = 0; k < batch.size(); ++k)
+     * {
+     *     u[batch.indices[k]] = f(batch.centers[0][k], batch.centers[1][k]);
+     * }
+     * @endcode
+     *
+     * The arrays are only valid during the call which gives the batch.
+     *
+     * @tparam dim_ The dimension of the cells.
+     * @tparam TInterval The type of the interval.
+     */
+    template <std::size_t dim_, class TInterval>
+    struct CellBatch
+    {
+        static constexpr std::size_t dim = dim_;
+        using interval_t                 = TInterval;
+        using index_t                    = typename interval_t::index_t;
+
+        std::size_t size() const
+        {
+            return indices.size();
+        }
+
+        /// The level of the cells.
+        std::size_t level = 0;
+
+        /// The length of the cells.
+        double length = 0;
+
+        /// The indices where the cells are in the data array.
+        std::span<const index_t> indices;
+
+        /// The coordinates of the centers: centers[d][k] along the direction d for the k-th cell.
+        std::array<std::span<const double>, dim> centers;
+    };
+
+    namespace detail
+    {
+        /// Storage of the arrays of the batches, reused from one interval to the next.
+        template <std::size_t dim, class TInterval>
+        class CellBatchBuffer
+        {
+          public:
+
+            using batch_t = CellBatch<dim, TInterval>;
+            using index_t = typename batch_t::index_t;
+
+            template <class LCA, class Index>
+            const batch_t& fill(const LCA& lca, const TInterval& interval, const Index& index_yz)
+            {
+                const auto size           = static_cast<std::size_t>(interval.size());
+                const double length       = lca.cell_length();
+                const auto& origin        = lca.origin_point();
+                const index_t first_index = interval.index + interval.start;
+
+                m_indices.resize(size);
+                for (std::size_t k = 0; k < size; ++k)
+                {
+                    m_indices[k] = first_index + static_cast<index_t>(k);
+                }
+
+                m_centers[0].resize(size);
+                for (std::size_t k = 0; k < size; ++k)
+                {
+                    m_centers[0][k] = origin[0] + length * (interval.start + static_cast<double>(k) + 0.5);
+                }
+                for (std::size_t d = 1; d < dim; ++d)
+                {
+                    m_centers[d].assign(size, origin[d] + length * (index_yz[d - 1] + 0.5));
+                }
+
+                m_batch.level   = lca.level();
+                m_batch.length  = length;
+                m_batch.indices = std::span<const index_t>(m_indices);
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    m_batch.centers[d] = std::span<const double>(m_centers[d]);
+                }
+                return m_batch;
+            }
+
+          private:
+
+            std::vector<index_t> m_indices;
+            std::array<std::vector<double>, dim> m_centers;
+            batch_t m_batch;
+        };
+    }
+}
@@ -7,6 +7,7 @@
 #include <array>
 #include <memory>
 #include <stdexcept>
+#include <tuple>
 #include <type_traits>
 
 #include <filesystem>
@@ -25,6 +26,7 @@ namespace fs = std::filesystem;
 #include "mesh_holder.hpp"
 #include "numeric/gauss_legendre.hpp"
 #include "storage/containers.hpp"
+#include "storage/memory_pool.hpp"
 #include "timers.hpp"
 
 namespace samurai
@@ -77,6 +79,190 @@ namespace samurai
             }
         };
 
+        /**
+         * Key of the MemoryPool::Placement of the arrays of the fields on
+         * mesh with the given layout: the pages of these arrays are placed by
+         * first_touch from the chunks of the cells of mesh, which only depend
+         * on its generation. It is 0, the placement being unknown, for the
+         * meshes without generation.
+         */
+        template <class Mesh>
+        inline std::size_t placement_key(const Mesh& mesh, [[maybe_unused]] bool soa)
+        {
+            if constexpr (requires { mesh.generation(); })
+            {
+                std::size_t key = mesh.generation();
+                ::hash_combine(key, soa);
+                return key;
+            }
+            else
+            {
+                return 0;
+            }
+        }
+
+        /**
+         * Set the new storage of a field to zero so that the memory of the
+         * cells is placed on the NUMA nodes of the threads which compute them.
+         *
+         * The cells are set first, with the chunks of mesh[cells] given to
+         * the threads as in for_each_cell<Run::Parallel>, for_each_cell_batch
+         * and the flat assignments of expressions: for these loops, a page
+         * which only holds the cells of one chunk is local to the thread of
+         * this chunk. The ghosts are then set with the chunks of
+         * mesh[reference], which doesn't move the pages already touched.
+         *
+         * The placement is approximate for the traversals of subsets
+         * (apply<Run::Parallel>), which split the rows along the last
+         * dimension and hand them out dynamically to the threads.
+         *
+         * An array reused from the MemoryPool in the Placement scope of the
+         * mesh (see placement_key) was already placed by a field of the same
+         * mesh and layout: it is not touched again.
+         */
+        template <class Mesh, class Storage>
+        inline void first_touch(const Mesh& mesh, Storage& storage, std::size_t old_size, const MemoryPool::Placement& placement)
+        {
+            using mesh_id_t = typename Mesh::mesh_id_t;
+
+            if (parallel::max_threads() > 1 && static_cast<std::size_t>(storage.data().size()) != old_size && !placement.reused())
+            {
+                const typename Storage::container_t::value_type zero{};
+                parallel_fill(mesh[mesh_id_t::cells], storage, zero);
+                parallel_fill(mesh[mesh_id_t::reference], storage, zero);
+            }
+        }
+
+        /**
+         * An expression is evaluated item by item on the arrays of the fields
+         * when it is made of fields with the same storage as Field, of scalars
+         * and of element-wise functions of them.
+         */
+        template <class Field, class E>
+        struct is_flat_expression : std::false_type
+        {
+        };
+
+        template <class mesh_t, class value_t, class other_value_t>
+        struct is_flat_expression<ScalarField<mesh_t, value_t>, ScalarField<mesh_t, other_value_t>> : std::true_type
+        {
+        };
+
+        template <class mesh_t, class value_t, class other_value_t, std::size_t n_comp, bool SOA>
+        struct is_flat_expression<VectorField<mesh_t, value_t, n_comp, SOA>, VectorField<mesh_t, other_value_t, n_comp, SOA>>
+            : std::true_type
+        {
+        };
+
+        template <class Field, class T>
+        struct is_flat_expression<Field, xt::xscalar<T>> : std::true_type
+        {
+        };
+
+        template <class Field, class F, class... CT>
+        struct is_flat_expression<Field, field_function<F, CT...>> : std::conjunction<is_flat_expression<Field, std::decay_t<CT>>...>
+        {
+        };
+
+        /// The fields of the expression must also be on the mesh of field.
+        template <class Field, class E>
+        bool has_flat_storage(const Field& field, const E& e)
+        {
+            if constexpr (is_field_function<E>::value)
+            {
+                return std::apply(
+                    [&](const auto&... args)
+                    {
+                        return (has_flat_storage(field, args) && ...);
+                    },
+                    e.arguments());
+            }
+            else if constexpr (has_mesh_t<E>::value)
+            {
+                return &e.mesh() == &field.mesh() && e.array().size() == field.array().size();
+            }
+            else
+            {
+                return true;
+            }
+        }
+
+        /// Function giving the value of the expression at the position k of the arrays.
+        template <class E>
+        auto flat_evaluator(const E& e)
+        {
+            if constexpr (is_field_function<E>::value)
+            {
+                return std::apply(
+                    [&](const auto&... args)
+                    {
+                        return [f = e.functor(), ... arg = flat_evaluator(args)](auto k)
+                        {
+                            return f(arg(k)...);
+                        };
+                    },
+                    e.arguments());
+            }
+            else if constexpr (has_mesh_t<E>::value)
+            {
+                return [data = e.array().data()](auto k)
+                {
+                    return data[k];
+                };
+            }
+            else
+            {
+                return [value = e()](auto)
+                {
+                    return value;
+                };
+            }
+        }
+
+        /**
+         * Assign the expression to the cells of field with contiguous loops
+         * over the arrays, instead of evaluating it interval by interval.
+         *
+         * @return false if the expression cannot be evaluated that way.
+         */
+        template <class Field, class E>
+        bool flat_assign(Field& field, const E& e)
+        {
+            if constexpr (is_flat_expression<Field, E>::value)
+            {
+                using mesh_id_t  = typename Field::mesh_t::mesh_id_t;
+                using value_type = typename Field::value_type;
+
+                if (!has_flat_storage(field, e))
+                {
+                    return false;
+                }
+
+                const auto eval = flat_evaluator(e);
+                value_type* out = field.array().data();
+                auto& storage   = field.m_storage;
+                parallel_for_each_index_range(field.mesh()[mesh_id_t::cells],
+                                              [&](auto first, auto last)
+                                              {
+                                                  using size_type = typename std::decay_t<decltype(storage)>::size_type;
+                                                  storage.for_each_range(static_cast<size_type>(first),
+                                                                         static_cast<size_type>(last),
+                                                                         [&](auto begin, auto end)
+                                                                         {
+                                                                             for (auto k = begin; k < end; ++k)
+                                                                             {
+                                                                                 out[k] = static_cast<value_type>(eval(k));
+                                                                             }
+                                                                         });
+                                              });
+                return true;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
         // ------------------------------------------------------------------------
         // struct inner_field_types
         // ------------------------------------------------------------------------
@@ -189,12 +375,16 @@ namespace samurai
 
             void resize()
             {
+                [[maybe_unused]] const auto old_size = static_cast<std::size_t>(m_storage.data().size());
+                const MemoryPool::Placement placement(detail::placement_key(this->derived_cast().mesh(), false));
                 m_storage.resize(static_cast<size_type>(this->derived_cast().mesh().nb_cells()));
 #ifdef SAMURAI_CHECK_NAN
                 if constexpr (std::is_floating_point_v<value_t>)
                 {
                     this->derived_cast().m_storage.data().fill(std::nan(""));
                 }
+#else
+                detail::first_touch(this->derived_cast().mesh(), m_storage, old_size, placement);
 #endif
             }
 
@@ -313,9 +503,13 @@ namespace samurai
 
             void resize()
             {
+                [[maybe_unused]] const auto old_size = static_cast<std::size_t>(m_storage.data().size());
+                const MemoryPool::Placement placement(detail::placement_key(this->derived_cast().mesh(), SOA));
                 m_storage.resize(static_cast<size_type>(this->derived_cast().mesh().nb_cells()));
 #ifdef SAMURAI_CHECK_NAN
                 m_storage.data().fill(std::nan(""));
+#else
+                detail::first_touch(this->derived_cast().mesh(), m_storage, old_size, placement);
 #endif
             }
 
@@ -485,6 +679,13 @@ namespace samurai
     inline auto VectorField<mesh_t, value_t, n_comp_, SOA>::operator=(const field_expression<E>& e) -> VectorField&
     {
         times::timers.start("field expressions");
+#ifndef SAMURAI_CHECK_NAN
+        if (detail::flat_assign(*this, e.derived_cast()))
+        {
+            times::timers.stop("field expressions");
+            return *this;
+        }
+#endif
         for_each_interval(this->mesh(),
                           [&](std::size_t level, const auto& i, const auto& index)
                           {
@@ -1096,6 +1297,13 @@ namespace samurai
     inline auto ScalarField<mesh_t, value_t>::operator=(const field_expression<E>& e) -> ScalarField&
     {
         times::timers.start("field expressions");
+#ifndef SAMURAI_CHECK_NAN
+        if (detail::flat_assign(*this, e.derived_cast()))
+        {
+            times::timers.stop("field expressions");
+            return *this;
+        }
+#endif
         for_each_interval(this->mesh(),
                           [&](std::size_t level, const auto& i, const auto& index)
                           {
@@ -109,6 +109,11 @@ namespace samurai
             return m_e;
         }
 
+        const functor_type& functor() const
+        {
+            return m_f;
+        }
+
       private:
 
         std::tuple<CT...> m_e;
@@ -0,0 +1,309 @@
+// Copyright 2018-2025 the samurai's authors
+// SPDX-License-Identifier:  BSD-3-Clause
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <iostream>
+#include <vector>
+
+#include <xtensor/xfixed.hpp>
+#include <xtensor/xview.hpp>
+
+#include "cell.hpp"
+#include "samurai_config.hpp"
+
+namespace samurai
+{
+    //////////////////////////////////
+    // FlatLevelCellList definition //
+    //////////////////////////////////
+
+    /** @class FlatLevelCellList
+     *  @brief Bulk builder with the same filling interface as LevelCellList.
+     *
+     * The intervals are appended unordered in a single contiguous buffer and
+     * are sorted and merged once, when the LevelCellArray is built. It avoids
+     * the node allocations and the pointer chasing of the nested std::map of
+     * LevelCellList when a whole level is filled at once.
+     *
+     * The rows can only be filled: the intervals of a given row cannot be read
+     * back, use LevelCellList if it is needed.
+     *
+     * @tparam Dim        The dimension.
+     * @tparam TInterval  The interval type.
+     */
+    template <std::size_t Dim, class TInterval = default_config::interval_t>
+    class FlatLevelCellList
+    {
+      public:
+
+        static constexpr auto dim = Dim;
+        using interval_t          = TInterval;
+        using index_t             = typename interval_t::index_t;
+        using coord_index_t       = typename interval_t::coord_index_t;
+        using index_yz_t          = xt::xtensor_fixed<coord_index_t, xt::xshape<dim - 1>>;
+        using coords_t            = xt::xtensor_fixed<double, xt::xshape<dim>>;
+
+        /// An x-interval tagged with its dim-1 coordinates.
+        struct entry_t
+        {
+            std::array<coord_index_t, dim - 1> yz;
+            coord_index_t start;
+            coord_index_t end;
+        };
+
+        /// Write-only access to the row at given dim-1 coordinates.
+        class row_type
+        {
+          public:
+
+            row_type(FlatLevelCellList& lcl, const index_yz_t& index);
+
+            void add_point(coord_index_t point);
+            void add_interval(const interval_t& interval);
+
+          private:
+
+            FlatLevelCellList* m_lcl;
+            std::array<coord_index_t, dim - 1> m_yz;
+        };
+
+        FlatLevelCellList();
+        FlatLevelCellList(std::size_t level);
+        FlatLevelCellList(std::size_t level, const coords_t& origin_point, double scaling_factor);
+
+        row_type operator[](const index_yz_t& index);
+
+        const std::vector<entry_t>& intervals() const;
+
+        std::size_t level() const;
+
+        bool empty() const;
+
+        void reserve(std::size_t size);
+
+        void to_stream(std::ostream& os) const;
+
+        void add_cell(const Cell<dim, interval_t>& cell);
+
+        auto& origin_point() const;
+        double scaling_factor() const;
+
+        void clear();
+
+      private:
+
+        static bool less(const entry_t& lhs, const entry_t& rhs);
+
+        void push_back(const std::array<coord_index_t, dim - 1>& yz, const interval_t& interval);
+        void sort_and_merge() const;
+
+        mutable std::vector<entry_t> m_intervals; ///< Sorted and merged lazily
+        mutable bool m_is_sorted = true;
+        std::size_t m_level;
+        coords_t m_origin_point;
+        double m_scaling_factor = 1;
+    };
+
+    //////////////////////////////////////
+    // FlatLevelCellList implementation //
+    //////////////////////////////////////
+    template <std::size_t Dim, class TInterval>
+    inline FlatLevelCellList<Dim, TInterval>::row_type::row_type(FlatLevelCellList& lcl, const index_yz_t& index)
+        : m_lcl(&lcl)
+    {
+        std::copy(index.cbegin(), index.cend(), m_yz.begin());
+    }
+
+    /// Add a point inside the row.
+    template <std::size_t Dim, class TInterval>
+    inline void FlatLevelCellList<Dim, TInterval>::row_type::add_point(coord_index_t point)
+    {
+        add_interval({point, point + 1});
+    }
+
+    /// Add an interval inside the row (invalid intervals are ignored).
+    template <std::size_t Dim, class TInterval>
+    inline void FlatLevelCellList<Dim, TInterval>::row_type::add_interval(const interval_t& interval)
+    {
+        if (interval.is_valid())
+        {
+            m_lcl->push_back(m_yz, interval);
+        }
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline FlatLevelCellList<Dim, TInterval>::FlatLevelCellList()
+        : m_level{0}
+    {
+        m_origin_point.fill(0);
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline FlatLevelCellList<Dim, TInterval>::FlatLevelCellList(std::size_t level)
+        : m_level{level}
+    {
+        m_origin_point.fill(0);
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline FlatLevelCellList<Dim, TInterval>::FlatLevelCellList(std::size_t level, const coords_t& origin_point, double scaling_factor)
+        : m_level{level}
+        , m_origin_point(origin_point)
+        , m_scaling_factor(scaling_factor)
+    {
+    }
+
+    /// Access to the row at given dim-1 coordinates
+    template <std::size_t Dim, class TInterval>
+    inline auto FlatLevelCellList<Dim, TInterval>::operator[](const index_yz_t& index) -> row_type
+    {
+        return {*this, index};
+    }
+
+    /**
+     * The intervals sorted along the rows (the outermost dimension first) and
+     * then along x. Overlapping and adjacent intervals of a row are merged as
+     * in ListOfIntervals.
+     */
+    template <std::size_t Dim, class TInterval>
+    inline auto FlatLevelCellList<Dim, TInterval>::intervals() const -> const std::vector<entry_t>&
+    {
+        sort_and_merge();
+        return m_intervals;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline std::size_t FlatLevelCellList<Dim, TInterval>::level() const
+    {
+        return m_level;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline bool FlatLevelCellList<Dim, TInterval>::empty() const
+    {
+        return m_intervals.empty();
+    }
+
+    /// Reserve the buffer for the given number of intervals.
+    template <std::size_t Dim, class TInterval>
+    inline void FlatLevelCellList<Dim, TInterval>::reserve(std::size_t size)
+    {
+        m_intervals.reserve(size);
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline void FlatLevelCellList<Dim, TInterval>::to_stream(std::ostream& os) const
+    {
+        os << "FlatLevelCellList\n";
+        os << "=================\n";
+        for (const auto& entry : intervals())
+        {
+            os << "(";
+            for (std::size_t d = 0; d < dim - 1; ++d)
+            {
+                os << entry.yz[d] << (d + 2 < dim ? ", " : "");
+            }
+            os << ") [" << entry.start << "," << entry.end << "[\n";
+        }
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline void FlatLevelCellList<Dim, TInterval>::add_cell(const Cell<dim, interval_t>& cell)
+    {
+        using namespace xt::placeholders;
+
+        (*this)[xt::view(cell.indices, xt::range(1, _))].add_point(cell.indices[0]);
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline auto& FlatLevelCellList<Dim, TInterval>::origin_point() const
+    {
+        return m_origin_point;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline double FlatLevelCellList<Dim, TInterval>::scaling_factor() const
+    {
+        return m_scaling_factor;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline void FlatLevelCellList<Dim, TInterval>::clear()
+    {
+        m_intervals.clear();
+        m_is_sorted = true;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline bool FlatLevelCellList<Dim, TInterval>::less(const entry_t& lhs, const entry_t& rhs)
+    {
+        for (std::size_t d = dim - 1; d > 0; --d)
+        {
+            if (lhs.yz[d - 1] != rhs.yz[d - 1])
+            {
+                return lhs.yz[d - 1] < rhs.yz[d - 1];
+            }
+        }
+        return lhs.start < rhs.start;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline void FlatLevelCellList<Dim, TInterval>::push_back(const std::array<coord_index_t, dim - 1>& yz, const interval_t& interval)
+    {
+        if (!m_intervals.empty())
+        {
+            auto& last = m_intervals.back();
+            // Most of the filling loops walk along x: extend the last interval
+            // in place when possible, it keeps the buffer sorted.
+            if (last.yz == yz && last.start <= interval.start && interval.start <= last.end)
+            {
+                last.end = std::max(last.end, interval.end);
+                return;
+            }
+            m_intervals.push_back({yz, interval.start, interval.end});
+            m_is_sorted = m_is_sorted && !less(m_intervals.back(), m_intervals[m_intervals.size() - 2]);
+        }
+        else
+        {
+            m_intervals.push_back({yz, interval.start, interval.end});
+        }
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline void FlatLevelCellList<Dim, TInterval>::sort_and_merge() const
+    {
+        if (m_is_sorted)
+        {
+            return;
+        }
+
+        std::sort(m_intervals.begin(), m_intervals.end(), less);
+
+        std::size_t last = 0;
+        for (std::size_t i = 1; i < m_intervals.size(); ++i)
+        {
+            auto& current = m_intervals[last];
+            if (m_intervals[i].yz == current.yz && m_intervals[i].start <= current.end)
+            {
+                current.end = std::max(current.end, m_intervals[i].end);
+            }
+            else
+            {
+                m_intervals[++last] = m_intervals[i];
+            }
+        }
+        m_intervals.resize(last + 1);
+        m_is_sorted = true;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline std::ostream& operator<<(std::ostream& out, const FlatLevelCellList<Dim, TInterval>& level_cell_list)
+    {
+        level_cell_list.to_stream(out);
+        return out;
+    }
+
+} // namespace samurai
@@ -1,5 +1,6 @@
 #pragma once
 #include "boundary.hpp"
+#include "parallel.hpp"
 #include "stencil.hpp"
 
 namespace samurai
@@ -50,8 +51,8 @@ namespace samurai
         {
             auto intersect = intersection(cells, shifted_cells);
 
-#ifdef SAMURAI_WITH_OPENMP
-            std::size_t num_threads = static_cast<std::size_t>(omp_get_max_threads());
+#ifdef SAMURAI_WITH_PARALLEL
+            std::size_t num_threads = parallel::max_threads();
             std::vector<IteratorStencil<Mesh, 2>> interface_its;
             std::vector<IteratorStencil<Mesh, comput_stencil_size>> comput_stencil_its;
             for (std::size_t i = 0; i < num_threads; ++i)
@@ -68,8 +69,8 @@ namespace samurai
                 intersect,
                 [&](auto mesh_interval)
                 {
-#ifdef SAMURAI_WITH_OPENMP
-                    std::size_t thread      = static_cast<std::size_t>(omp_get_thread_num());
+#ifdef SAMURAI_WITH_PARALLEL
+                    std::size_t thread      = parallel::thread_num();
                     auto& interface_it      = interface_its[thread];
                     auto& comput_stencil_it = comput_stencil_its[thread];
 #endif
@@ -142,8 +143,8 @@ namespace samurai
 
             int direction_index_int = comput_stencil.find(direction);
             auto direction_index    = static_cast<std::size_t>(direction_index_int);
-#ifdef SAMURAI_WITH_OPENMP
-            std::size_t num_threads = static_cast<std::size_t>(omp_get_max_threads());
+#ifdef SAMURAI_WITH_PARALLEL
+            std::size_t num_threads = parallel::max_threads();
             std::vector<IteratorStencil<Mesh, comput_stencil_size>> comput_stencil_its;
             comput_stencil_its.reserve(num_threads);
             std::vector<LevelJumpIterator<0, Mesh, comput_stencil_size>> interface_its;
@@ -162,8 +163,8 @@ namespace samurai
                 fine_intersect,
                 [&](auto fine_mesh_interval)
                 {
-#ifdef SAMURAI_WITH_OPENMP
-                    std::size_t thread      = static_cast<std::size_t>(omp_get_thread_num());
+#ifdef SAMURAI_WITH_PARALLEL
+                    std::size_t thread      = parallel::thread_num();
                     auto& interface_it      = interface_its[thread];
                     auto& comput_stencil_it = comput_stencil_its[thread];
 #endif
@@ -240,8 +241,8 @@ namespace samurai
             int minus_direction_index_int                           = minus_comput_stencil.find(minus_direction);
             auto minus_direction_index                              = static_cast<std::size_t>(minus_direction_index_int);
 
-#ifdef SAMURAI_WITH_OPENMP
-            std::size_t num_threads = static_cast<std::size_t>(omp_get_max_threads());
+#ifdef SAMURAI_WITH_PARALLEL
+            std::size_t num_threads = parallel::max_threads();
             std::vector<IteratorStencil<Mesh, comput_stencil_size>> comput_stencil_its;
             comput_stencil_its.reserve(num_threads);
             std::vector<LevelJumpIterator<1, Mesh, comput_stencil_size>> interface_its;
@@ -260,8 +261,8 @@ namespace samurai
                 fine_intersect,
                 [&](auto fine_mesh_interval)
                 {
-#ifdef SAMURAI_WITH_OPENMP
-                    std::size_t thread            = static_cast<std::size_t>(omp_get_thread_num());
+#ifdef SAMURAI_WITH_PARALLEL
+                    std::size_t thread            = parallel::thread_num();
                     auto& interface_it            = interface_its[thread];
                     auto& minus_comput_stencil_it = comput_stencil_its[thread];
 #endif
@@ -430,8 +431,8 @@ namespace samurai
         Stencil<2, dim> interface_stencil_ = in_out_stencil<dim>(direction);
         auto interface_stencil             = make_stencil_analyzer(interface_stencil_);
 
-#ifdef SAMURAI_WITH_OPENMP
-        std::size_t num_threads = static_cast<std::size_t>(omp_get_max_threads());
+#ifdef SAMURAI_WITH_PARALLEL
+        std::size_t num_threads = parallel::max_threads();
         std::vector<IteratorStencil<Mesh, 2>> interface_its;
         std::vector<IteratorStencil<Mesh, comput_stencil_size>> comput_stencil_its;
         for (std::size_t i = 0; i < num_threads; ++i)
@@ -448,8 +449,8 @@ namespace samurai
         for_each_meshinterval<mesh_interval_t, run_type>(bdry,
                                                          [&](auto mesh_interval)
                                                          {
-#ifdef SAMURAI_WITH_OPENMP
-                                                             std::size_t thread      = static_cast<std::size_t>(omp_get_thread_num());
+#ifdef SAMURAI_WITH_PARALLEL
+                                                             std::size_t thread      = parallel::thread_num();
                                                              auto& interface_it      = interface_its[thread];
                                                              auto& comput_stencil_it = comput_stencil_its[thread];
 #endif
@@ -44,6 +44,11 @@ namespace samurai
      * @c Interval that contains the result of the same operation
      * applied on the real interval.
      *
+     * The storage footprint of the mesh is driven by the size of this
+     * structure: with 32-bit coordinates, a 64-bit index leads to 24 bytes
+     * (because of padding) whereas a 32-bit index leads to 16 bytes
+     * (see default_config::compact_interval_t).
+     *
      * @tparam TValue  The coordinate type (must be signed).
      * @tparam TIndex  The index type (must be signed).
      */
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include <filesystem>
 namespace fs = std::filesystem;
 
@@ -34,10 +35,10 @@ namespace HighFive
         AtomicType()
             : DataType(CompoundType(
                   {
-                      {"start", create_datatype<value_t>()},
-                      {"end", create_datatype<value_t>(), sizeof(value_t)},
-                      {"step", create_datatype<value_t>(), 2 * sizeof(value_t)},
-                      {"index", create_datatype<index_t>(), 4 * sizeof(value_t)}
+                      {"start", create_datatype<value_t>(), offsetof(samurai::Interval<value_t, index_t>, start)},
+                      {"end", create_datatype<value_t>(), offsetof(samurai::Interval<value_t, index_t>, end)},
+                      {"step", create_datatype<value_t>(), offsetof(samurai::Interval<value_t, index_t>, step)},
+                      {"index", create_datatype<index_t>(), offsetof(samurai::Interval<value_t, index_t>, index)}
         },
                   sizeof(samurai::Interval<value_t, index_t>)))
         {
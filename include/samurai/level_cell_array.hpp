@@ -3,10 +3,15 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cstdint>
 #include <iterator>
 #include <limits>
+#include <memory>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #ifdef SAMURAI_WITH_MPI
@@ -19,9 +24,11 @@
 
 #include "algorithm.hpp"
 #include "box.hpp"
+#include "flat_level_cell_list.hpp"
 #include "interval.hpp"
 #include "level_cell_list.hpp"
 #include "mesh_interval.hpp"
+#include "parallel.hpp"
 #include "samurai_config.hpp"
 #include "subset/node.hpp"
 #include "utils.hpp"
@@ -60,6 +67,95 @@ namespace samurai
         }
     };
 
+    namespace detail
+    {
+        /**
+         * A value computed on demand by const methods, which may be called
+         * concurrently (Run::Parallel loops).
+         *
+         * The first caller claims the computation and publishes the value with
+         * release ordering, the next ones read it after an acquire load. A
+         * caller which comes while the value is being computed gets its own
+         * copy. reset() is called by the modifications, which must not be
+         * concurrent with the reads.
+         */
+        template <class T>
+        class lazy_value
+        {
+          public:
+
+            lazy_value() = default;
+
+            lazy_value(const lazy_value& other)
+            {
+                copy(other);
+            }
+
+            lazy_value& operator=(const lazy_value& other)
+            {
+                if (this != &other)
+                {
+                    copy(other);
+                }
+                return *this;
+            }
+
+            template <class Compute>
+            T get(Compute&& compute) const
+            {
+                if (m_state.load(std::memory_order_acquire) == valid)
+                {
+                    return m_value;
+                }
+                int expected = invalid;
+                if (m_state.compare_exchange_strong(expected, computing, std::memory_order_acquire))
+                {
+                    m_value = compute();
+                    m_state.store(valid, std::memory_order_release);
+                    return m_value;
+                }
+                return compute();
+            }
+
+            void set(const T& value)
+            {
+                m_value = value;
+                m_state.store(valid, std::memory_order_release);
+            }
+
+            void reset()
+            {
+                m_state.store(invalid, std::memory_order_relaxed);
+            }
+
+            bool is_valid() const
+            {
+                return m_state.load(std::memory_order_acquire) == valid;
+            }
+
+          private:
+
+            void copy(const lazy_value& other)
+            {
+                if (other.is_valid())
+                {
+                    set(other.m_value);
+                }
+                else
+                {
+                    reset();
+                }
+            }
+
+            static constexpr int invalid   = 0;
+            static constexpr int computing = 1;
+            static constexpr int valid     = 2;
+
+            mutable T m_value{};
+            mutable std::atomic<int> m_state = invalid;
+        };
+    }
+
     ///////////////////////////////
     // LevelCellArray definition //
     ///////////////////////////////
@@ -91,11 +187,22 @@ namespace samurai
 
         static constexpr double default_approx_box_tol = 0.05;
 
+#ifdef SAMURAI_WITH_PARALLEL
+        static constexpr Run default_construction_run = Run::Parallel;
+#else
+        static constexpr Run default_construction_run = Run::Sequential;
+#endif
+        /// Minimal number of rows along the last dimension built by a thread
+        static constexpr std::size_t min_rows_per_chunk = 64;
+        /// Width in cells, as a power of two, of the tiles numbered along a Morton curve by update_index_morton
+        static constexpr std::size_t morton_tile_bits = 4;
+
         LevelCellArray() = default;
-        LevelCellArray(const LevelCellList<Dim, TInterval>& lcl);
+        LevelCellArray(const LevelCellList<Dim, TInterval>& lcl, Run run = default_construction_run);
+        LevelCellArray(const FlatLevelCellList<Dim, TInterval>& lcl, Run run = default_construction_run);
 
         template <class Op, class StartEndOp, class... S>
-        LevelCellArray(Subset<Op, StartEndOp, S...> set);
+        LevelCellArray(Subset<Op, StartEndOp, S...> set, Run run = default_construction_run);
 
         LevelCellArray(std::size_t level, const Box<value_t, dim>& box);
         LevelCellArray(std::size_t level,
@@ -121,6 +228,7 @@ namespace samurai
         const_iterator end() const;
         const_iterator cbegin() const;
         const_iterator cend() const;
+        const_iterator citerator_at(std::size_t position) const;
 
         reverse_iterator rbegin();
         reverse_iterator rend();
@@ -155,6 +263,17 @@ namespace samurai
         cell_t get_cell(const xt::xexpression<E>& coord) const;
 
         void update_index();
+        std::size_t update_index_morton(std::size_t first_index = 0);
+        template <class Func>
+        void update_index(Func&& new_index);
+
+        //// checks whether the cells are the same, whatever the indices of the x-intervals
+        bool has_same_cells(const LevelCellArray& other) const;
+
+        //// Gives a hash of the cells, whatever the indices of the x-intervals
+        std::size_t hash() const;
+        //// checks whether hash() is up to date and will not scan the cells
+        bool is_hash_valid() const;
 
         //// checks whether the container is empty
         bool empty() const;
@@ -211,6 +330,8 @@ namespace samurai
                 ar& m_offsets[d];
             }
             ar & m_level;
+            m_hash.reset();
+            m_bounds.reset();
         }
 #endif
         template <bool isIntervalListEmpty, bool isParentPointNew, size_t d>
@@ -220,6 +341,13 @@ namespace samurai
         template <typename TGrid, std::size_t N>
         void init_from_level_cell_list(const TGrid& grid, std::array<value_t, dim - 1> index, std::integral_constant<std::size_t, N>);
 
+        /// Construction from a range of positions along dimension > 0
+        template <typename TGridIterator, std::size_t N>
+        void init_from_level_cell_list(TGridIterator first,
+                                       TGridIterator last,
+                                       std::array<value_t, dim - 1> index,
+                                       std::integral_constant<std::size_t, N>);
+
         /// Recursive construction from a level cell list for the dimension 0
         template <typename TIntervalList>
         void init_from_level_cell_list(const TIntervalList& interval_list,
@@ -229,12 +357,27 @@ namespace samurai
         void init_from_box(const Box<value_t, dim>& box);
         void init_from_box(const Box<double, dim>& box, const coords_t& origin_point, double approx_box_tol, double scaling_factor);
 
+        static std::size_t nb_construction_chunks(std::size_t nb_rows);
+
+        template <class Func>
+        void init_by_chunks(std::size_t nb_chunks, Func&& init_chunk);
+
+        void concatenate(const std::vector<LevelCellArray>& parts);
+
+        void update_caches();
+        std::size_t compute_hash() const;
+        std::array<std::array<value_t, dim>, 2> compute_bounds() const;
+
         std::array<std::vector<interval_t>, dim> m_cells;        ///< All intervals in every direction
         std::array<std::vector<std::size_t>, dim - 1> m_offsets; ///< Offsets in interval list for each dim >
                                                                  ///< 1
         std::size_t m_level = 0;
         coords_t m_origin_point;
         double m_scaling_factor = 1;
+
+        // reset by every modification of the intervals
+        detail::lazy_value<std::size_t> m_hash;                               ///< See hash()
+        detail::lazy_value<std::array<std::array<value_t, dim>, 2>> m_bounds; ///< See min_indices() and max_indices()
     };
 
     ////////////////////////////////////////
@@ -309,8 +452,15 @@ namespace samurai
     ///////////////////////////////////
     // LevelCellArray implementation //
     ///////////////////////////////////
+    /**
+     * Construction from a level cell list.
+     *
+     * With Run::Parallel, the positions along the last dimension are split
+     * into chunks built concurrently and concatenated afterwards. The result
+     * is identical to the sequential construction.
+     */
     template <std::size_t Dim, class TInterval>
-    inline LevelCellArray<Dim, TInterval>::LevelCellArray(const LevelCellList<Dim, TInterval>& lcl)
+    inline LevelCellArray<Dim, TInterval>::LevelCellArray(const LevelCellList<Dim, TInterval>& lcl, Run run)
         : m_level(lcl.level())
         , m_origin_point(lcl.origin_point())
         , m_scaling_factor(lcl.scaling_factor())
@@ -327,6 +477,37 @@ namespace samurai
          * NOTE2: in fact, hard setting the optimal values for cnt_x and cnt_yz
          * doesn't speedup things, strang...
          */
+        if constexpr (dim > 1)
+        {
+            const auto& grid            = lcl.grid_yz();
+            const std::size_t nb_chunks = run == Run::Parallel ? nb_construction_chunks(grid.size()) : 1;
+            if (nb_chunks > 1)
+            {
+                std::vector<typename LevelCellList<Dim, TInterval>::grid_t::const_iterator> bounds;
+                bounds.reserve(nb_chunks + 1);
+                auto it = grid.cbegin();
+                for (std::size_t c = 0, pos = 0; c < nb_chunks; ++c)
+                {
+                    const std::size_t next_pos = c * grid.size() / nb_chunks;
+                    std::advance(it, static_cast<std::ptrdiff_t>(next_pos - pos));
+                    pos = next_pos;
+                    bounds.push_back(it);
+                }
+                bounds.push_back(grid.cend());
+
+                init_by_chunks(nb_chunks,
+                               [&](LevelCellArray& part, std::size_t c)
+                               {
+                                   part.init_from_level_cell_list(bounds[c], bounds[c + 1], {}, std::integral_constant<std::size_t, dim - 1>{});
+                                   for (std::size_t d = 0; d < dim - 1; ++d)
+                                   {
+                                       part.m_offsets[d].emplace_back(part.m_cells[d].size());
+                                   }
+                               });
+                return;
+            }
+        }
+
         if (!lcl.empty())
         {
             // Filling cells and offsets from the level cell list
@@ -338,18 +519,102 @@ namespace samurai
                 m_offsets[d].emplace_back(m_cells[d].size());
             }
         }
+        update_caches();
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline LevelCellArray<Dim, TInterval>::LevelCellArray(const FlatLevelCellList<Dim, TInterval>& lcl, Run run)
+        : m_level(lcl.level())
+        , m_origin_point(lcl.origin_point())
+        , m_scaling_factor(lcl.scaling_factor())
+    {
+        // The intervals are already sorted and merged: they are appended as is
+        const auto& intervals = lcl.intervals();
+        auto add_intervals    = [&intervals](LevelCellArray& lca, std::size_t first, std::size_t last)
+        {
+            fixed_array<value_t, dim - 1> yz;
+            for (std::size_t i = first; i < last; ++i)
+            {
+                std::copy(intervals[i].yz.cbegin(), intervals[i].yz.cend(), yz.begin());
+                lca.add_interval_back({intervals[i].start, intervals[i].end}, yz);
+            }
+        };
+
+        if constexpr (dim > 1)
+        {
+            const std::size_t nb_chunks = run == Run::Parallel ? nb_construction_chunks(intervals.size()) : 1;
+            if (nb_chunks > 1)
+            {
+                // A chunk must not split the intervals of a position along the last dimension
+                std::vector<std::size_t> bounds(nb_chunks + 1, intervals.size());
+                bounds[0] = 0;
+                for (std::size_t c = 1; c < nb_chunks; ++c)
+                {
+                    std::size_t pos = std::max(c * intervals.size() / nb_chunks, bounds[c - 1]);
+                    while (pos > 0 && pos < intervals.size() && intervals[pos].yz[dim - 2] == intervals[pos - 1].yz[dim - 2])
+                    {
+                        ++pos;
+                    }
+                    bounds[c] = pos;
+                }
+
+                init_by_chunks(nb_chunks,
+                               [&](LevelCellArray& part, std::size_t c)
+                               {
+                                   add_intervals(part, bounds[c], bounds[c + 1]);
+                               });
+                return;
+            }
+        }
+        add_intervals(*this, 0, intervals.size());
+        update_caches();
     }
 
     template <std::size_t Dim, class TInterval>
     template <class Op, class StartEndOp, class... S>
-    inline LevelCellArray<Dim, TInterval>::LevelCellArray(Subset<Op, StartEndOp, S...> set)
+    inline LevelCellArray<Dim, TInterval>::LevelCellArray(Subset<Op, StartEndOp, S...> set, Run run)
         : m_level(set.level())
     {
+        m_origin_point.fill(0);
+        if constexpr (dim > 1)
+        {
+            if (run == Run::Parallel && set.exist())
+            {
+                // List the positions along the last dimension: each of them
+                // is then traversed independently on a copy of the set.
+                xt::xtensor_fixed<int, xt::xshape<dim - 1>> index;
+                const auto rows = detail::outer_positions(set, index);
+
+                const std::size_t nb_chunks = nb_construction_chunks(rows.size());
+                if (nb_chunks > 1)
+                {
+                    init_by_chunks(nb_chunks,
+                                   [&](LevelCellArray& part, std::size_t c)
+                                   {
+                                       auto local_set   = set;
+                                       auto local_index = index;
+                                       auto func        = [&part](const auto& i, const auto& yz)
+                                       {
+                                           part.add_interval_back(i, yz);
+                                           return false;
+                                       };
+                                       for (std::size_t r = c * rows.size() / nb_chunks; r < (c + 1) * rows.size() / nb_chunks; ++r)
+                                       {
+                                           local_index[dim - 2] = rows[r];
+                                           detail::apply_impl<dim - 1>(local_set, func, local_index);
+                                       }
+                                   });
+                    return;
+                }
+            }
+        }
+
         set(
             [this](const auto& i, const auto& index)
             {
                 add_interval_back(i, index);
             });
+        update_caches();
     }
 
     template <std::size_t Dim, class TInterval>
@@ -387,6 +652,7 @@ namespace samurai
         : m_level{level}
     {
         m_origin_point.fill(0);
+        update_caches();
     }
 
     template <std::size_t Dim, class TInterval>
@@ -395,6 +661,7 @@ namespace samurai
         , m_origin_point(origin_point)
         , m_scaling_factor(scaling_factor)
     {
+        update_caches();
     }
 
     ////////////////////////////////////////////////////////////////////
@@ -408,6 +675,8 @@ namespace samurai
     template <std::size_t Dim, class TInterval>
     inline void LevelCellArray<Dim, TInterval>::add_interval_back(const interval_t& x_interval, const fixed_array<value_t, Dim - 1>& yz)
     {
+        m_hash.reset();
+        m_bounds.reset();
         if (m_cells[Dim - 1].empty())
         {
             add_interval_back_rec<true, true, Dim - 1>(x_interval, yz);
@@ -485,6 +754,10 @@ namespace samurai
     template <std::size_t Dim, class TInterval>
     inline auto LevelCellArray<Dim, TInterval>::begin() -> iterator
     {
+        // the intervals may be modified through the returned iterator
+        m_hash.reset();
+        m_bounds.reset();
+
         typename iterator::offset_type_iterator offset_index;
         typename iterator::iterator_container current_index;
         typename iterator::coord_type index;
@@ -505,6 +778,10 @@ namespace samurai
     template <std::size_t Dim, class TInterval>
     inline auto LevelCellArray<Dim, TInterval>::end() -> iterator
     {
+        // the intervals may be modified through the returned iterator
+        m_hash.reset();
+        m_bounds.reset();
+
         typename iterator::offset_type_iterator offset_index;
         typename iterator::iterator_container current_index;
         typename iterator::coord_type index;
@@ -566,6 +843,42 @@ namespace samurai
         return const_iterator(this, std::move(offset_index), std::move(current_index), std::move(index));
     }
 
+    /**
+     * Iterator on the interval at the given position along x, found by
+     * bisection on the offsets and on the intervals of each dimension.
+     */
+    template <std::size_t Dim, class TInterval>
+    inline auto LevelCellArray<Dim, TInterval>::citerator_at(std::size_t position) const -> const_iterator
+    {
+        if (position >= m_cells[0].size())
+        {
+            return cend();
+        }
+
+        typename const_iterator::offset_type_iterator offset_index;
+        typename const_iterator::iterator_container current_index;
+        typename const_iterator::coord_type index;
+
+        current_index[0] = m_cells[0].cbegin() + static_cast<std::ptrdiff_t>(position);
+        for (std::size_t d = 0; d < dim - 1; ++d)
+        {
+            // the offsets give the first interval along d of each position along d + 1
+            const auto pos  = static_cast<std::size_t>(std::distance(m_cells[d].cbegin(), current_index[d]));
+            offset_index[d] = std::prev(std::upper_bound(m_offsets[d].cbegin(), m_offsets[d].cend(), pos));
+
+            const auto io        = static_cast<index_t>(std::distance(m_offsets[d].cbegin(), offset_index[d]));
+            current_index[d + 1] = std::prev(std::upper_bound(m_cells[d + 1].cbegin(),
+                                                              m_cells[d + 1].cend(),
+                                                              io,
+                                                              [](auto value, const auto& interval)
+                                                              {
+                                                                  return value < interval.index + interval.start;
+                                                              }));
+            index[d]             = static_cast<value_t>(io - current_index[d + 1]->index);
+        }
+        return const_iterator(this, std::move(offset_index), std::move(current_index), std::move(index));
+    }
+
     template <std::size_t Dim, class TInterval>
     inline auto LevelCellArray<Dim, TInterval>::begin() const -> const_iterator
     {
@@ -731,12 +1044,186 @@ namespace samurai
     inline void LevelCellArray<Dim, TInterval>::update_index()
     {
         std::size_t acc_size = 0;
-        for_each_interval(*this,
-                          [&](auto, auto& interval, auto)
+        update_index(
+            [&](const auto& interval, const auto&)
+            {
+                auto index = safe_subs<index_t>(acc_size, interval.start);
+                acc_size += interval.size();
+                return index;
+            });
+        check_index_capacity<index_t>(acc_size, m_level);
+    }
+
+    /**
+     * Set the index of each x-interval to new_index(interval, index_yz), the
+     * x-intervals being visited in order.
+     *
+     * Unlike the mutable iterators, the hash and the bounds of the cells are
+     * kept since they do not depend on the indices.
+     */
+    template <std::size_t Dim, class TInterval>
+    template <class Func>
+    inline void LevelCellArray<Dim, TInterval>::update_index(Func&& new_index)
+    {
+        if (empty())
+        {
+            return;
+        }
+        for (auto it = cbegin(); it != cend(); ++it)
+        {
+            auto position              = static_cast<std::size_t>(std::addressof(*it) - m_cells[0].data());
+            m_cells[0][position].index = new_index(*it, it.index());
+        }
+    }
+
+    /**
+     * Numbering of the x-intervals by tiles of 2^morton_tile_bits cells in
+     * each direction, starting at first_index: the tiles are numbered along a
+     * Morton curve and the x-intervals of a tile in lexicographic order, so
+     * that the rows of a tile, which are neighbours along y and z, are close
+     * in memory.
+     *
+     * The cells of an interval stay contiguous so that they are still
+     * addressed by interval.index + i: an interval belongs to the tile of its
+     * first cell. The intervals wider than a tile are therefore not split and
+     * the rows which span the whole level keep the lexicographic order.
+     *
+     * @return the index following the last cell.
+     */
+    template <std::size_t Dim, class TInterval>
+    inline std::size_t LevelCellArray<Dim, TInterval>::update_index_morton(std::size_t first_index)
+    {
+        if (empty())
+        {
+            return first_index;
+        }
+
+        const auto min_corner = min_indices();
+        const auto max_corner = max_indices();
+        std::size_t nb_bits   = 1;
+        for (std::size_t d = 0; d < dim; ++d)
+        {
+            while (nb_bits < 64 / dim && (static_cast<std::uint64_t>(max_corner[d] - min_corner[d]) >> (morton_tile_bits + nb_bits)) != 0)
+            {
+                ++nb_bits;
+            }
+        }
+
+        // positions of the x-intervals: they are numbered through m_cells to keep the hash and the bounds
+        std::vector<std::pair<std::uint64_t, std::size_t>> keys;
+        keys.reserve(m_cells[0].size());
+        for_each_interval(std::as_const(*this),
+                          [&](auto, const auto& interval, const auto& index)
                           {
-                              interval.index = safe_subs<index_t>(acc_size, interval.start);
-                              acc_size += interval.size();
+                              std::array<std::uint64_t, dim> tile;
+                              tile[0] = static_cast<std::uint64_t>(interval.start - min_corner[0]) >> morton_tile_bits;
+                              for (std::size_t d = 1; d < dim; ++d)
+                              {
+                                  tile[d] = static_cast<std::uint64_t>(index[d - 1] - min_corner[d]) >> morton_tile_bits;
+                              }
+                              keys.emplace_back(morton_code(tile, nb_bits), static_cast<std::size_t>(&interval - m_cells[0].data()));
                           });
+        // the intervals are traversed in lexicographic order, which is kept inside the tiles
+        std::stable_sort(keys.begin(),
+                         keys.end(),
+                         [](const auto& a, const auto& b)
+                         {
+                             return a.first < b.first;
+                         });
+
+        std::size_t acc_size = first_index;
+        for (const auto& key : keys)
+        {
+            auto& interval = m_cells[0][key.second];
+            interval.index = safe_subs<index_t>(acc_size, interval.start);
+            acc_size += interval.size();
+        }
+        check_index_capacity<index_t>(acc_size, m_level);
+        return acc_size;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline bool LevelCellArray<Dim, TInterval>::has_same_cells(const LevelCellArray& other) const
+    {
+        if (m_level != other.m_level || shape() != other.shape() || hash() != other.hash())
+        {
+            return false;
+        }
+
+        // The intervals along y, z, ... only depend on the cells, the
+        // x-intervals are compared without their index.
+        if (!std::equal(m_cells[0].cbegin(),
+                        m_cells[0].cend(),
+                        other.m_cells[0].cbegin(),
+                        [](const auto& i1, const auto& i2)
+                        {
+                            return i1.start == i2.start && i1.end == i2.end;
+                        }))
+        {
+            return false;
+        }
+        for (std::size_t d = 1; d < dim; ++d)
+        {
+            if (m_cells[d] != other.m_cells[d] || m_offsets[d - 1] != other.m_offsets[d - 1])
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /**
+     * The hash is built with the cells by the constructors and recomputed on
+     * demand after a modification. It depends on the bounds of the intervals
+     * and on the offsets but not on the indices of the x-intervals: two arrays
+     * with different hashes have different cells, the converse needs a full
+     * comparison.
+     */
+    template <std::size_t Dim, class TInterval>
+    inline std::size_t LevelCellArray<Dim, TInterval>::hash() const
+    {
+        return m_hash.get(
+            [this]()
+            {
+                return compute_hash();
+            });
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline bool LevelCellArray<Dim, TInterval>::is_hash_valid() const
+    {
+        return m_hash.is_valid();
+    }
+
+    /// The hash and the bounds are computed at the end of the constructions: the reads then don't write anything.
+    template <std::size_t Dim, class TInterval>
+    inline void LevelCellArray<Dim, TInterval>::update_caches()
+    {
+        m_hash.set(compute_hash());
+        m_bounds.set(compute_bounds());
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline std::size_t LevelCellArray<Dim, TInterval>::compute_hash() const
+    {
+        std::size_t seed = m_level;
+        for (std::size_t d = 0; d < dim; ++d)
+        {
+            ::hash_combine(seed, m_cells[d].size());
+            for (const auto& interval : m_cells[d])
+            {
+                ::hash_combine(seed, interval.start);
+                ::hash_combine(seed, interval.end);
+            }
+        }
+        for (std::size_t d = 0; d < dim - 1; ++d)
+        {
+            for (const auto offset : m_offsets[d])
+            {
+                ::hash_combine(seed, offset);
+            }
+        }
+        return seed;
     }
 
     template <std::size_t Dim, class TInterval>
@@ -793,6 +1280,8 @@ namespace samurai
             m_offsets[d].clear();
         }
         m_cells[dim - 1].clear();
+        m_hash.reset();
+        m_bounds.reset();
     }
 
     template <std::size_t Dim, class TInterval>
@@ -804,22 +1293,17 @@ namespace samurai
     /**
      * Return the maximum value that can take the end of an interval for each
      * direction.
+     *
+     * The bounds are computed once and kept until the intervals are modified.
      */
     template <std::size_t Dim, class TInterval>
     inline auto LevelCellArray<Dim, TInterval>::max_indices() const
     {
-        std::array<value_t, dim> max;
-        for (std::size_t d = 0; d < dim; ++d)
-        {
-            max[d] = std::max_element(m_cells[d].begin(),
-                                      m_cells[d].end(),
-                                      [](const auto& a, const auto& b)
-                                      {
-                                          return (a.end < b.end);
-                                      })
-                         ->end;
-        }
-        return max;
+        return m_bounds.get(
+            [this]()
+            {
+                return compute_bounds();
+            })[1];
     }
 
     /**
@@ -829,18 +1313,40 @@ namespace samurai
     template <std::size_t Dim, class TInterval>
     inline auto LevelCellArray<Dim, TInterval>::min_indices() const
     {
-        std::array<value_t, dim> min;
+        return m_bounds.get(
+            [this]()
+            {
+                return compute_bounds();
+            })[0];
+    }
+
+    /// The minimum starts and the maximum ends of the intervals in each direction.
+    template <std::size_t Dim, class TInterval>
+    inline auto LevelCellArray<Dim, TInterval>::compute_bounds() const -> std::array<std::array<value_t, dim>, 2>
+    {
+        std::array<std::array<value_t, dim>, 2> bounds{};
         for (std::size_t d = 0; d < dim; ++d)
         {
-            min[d] = std::min_element(m_cells[d].begin(),
-                                      m_cells[d].end(),
-                                      [](const auto& a, const auto& b)
-                                      {
-                                          return (a.start < b.start);
-                                      })
-                         ->start;
+            if (m_cells[d].empty())
+            {
+                continue;
+            }
+            bounds[0][d] = std::min_element(m_cells[d].begin(),
+                                            m_cells[d].end(),
+                                            [](const auto& a, const auto& b)
+                                            {
+                                                return (a.start < b.start);
+                                            })
+                               ->start;
+            bounds[1][d] = std::max_element(m_cells[d].begin(),
+                                            m_cells[d].end(),
+                                            [](const auto& a, const auto& b)
+                                            {
+                                                return (a.end < b.end);
+                                            })
+                               ->end;
         }
-        return min;
+        return bounds;
     }
 
     /**
@@ -928,6 +1434,9 @@ namespace samurai
     template <std::size_t Dim, class TInterval>
     inline auto LevelCellArray<Dim, TInterval>::operator[](std::size_t d) -> std::vector<interval_t>&
     {
+        // the intervals may be modified through the returned reference
+        m_hash.reset();
+        m_bounds.reset();
         return m_cells[d];
     }
 
@@ -942,6 +1451,7 @@ namespace samurai
     inline std::vector<std::size_t>& LevelCellArray<Dim, TInterval>::offsets(std::size_t d)
     {
         assert(d > 0);
+        m_hash.reset();
         return m_offsets[d - 1];
     }
 
@@ -950,13 +1460,24 @@ namespace samurai
     inline void LevelCellArray<Dim, TInterval>::init_from_level_cell_list(const TGrid& grid,
                                                                           std::array<value_t, dim - 1> index,
                                                                           std::integral_constant<std::size_t, N>)
+    {
+        init_from_level_cell_list(grid.cbegin(), grid.cend(), index, std::integral_constant<std::size_t, N>{});
+    }
+
+    template <std::size_t Dim, class TInterval>
+    template <typename TGridIterator, std::size_t N>
+    inline void LevelCellArray<Dim, TInterval>::init_from_level_cell_list(TGridIterator first,
+                                                                          TGridIterator last,
+                                                                          std::array<value_t, dim - 1> index,
+                                                                          std::integral_constant<std::size_t, N>)
     {
         // Working interval
         interval_t curr_interval(0, 0, 0);
 
         // For each position along the Nth dimension
-        for (const auto& point : grid)
+        for (; first != last; ++first)
         {
+            const auto& point = *first;
             // Coordinate along the Nth dimension
             const auto i = point.first;
 
@@ -1020,6 +1541,131 @@ namespace samurai
         std::copy(interval_list.begin(), interval_list.end(), std::back_inserter(m_cells[0]));
     }
 
+    /// Number of chunks used to build concurrently an array of nb_rows positions along the last dimension
+    template <std::size_t Dim, class TInterval>
+    inline std::size_t LevelCellArray<Dim, TInterval>::nb_construction_chunks(std::size_t nb_rows)
+    {
+        if (parallel::in_parallel())
+        {
+            return 1;
+        }
+        const std::size_t nb_threads = parallel::max_threads();
+        // A few chunks per thread to balance the rows of uneven sizes
+        return std::max(std::size_t{1}, std::min(4 * nb_threads, nb_rows / min_rows_per_chunk));
+    }
+
+    /**
+     * Build each chunk in its own array with init_chunk(part, chunk_id) and
+     * concatenate them. The chunks must cover increasing positions along the
+     * last dimension.
+     */
+    template <std::size_t Dim, class TInterval>
+    template <class Func>
+    inline void LevelCellArray<Dim, TInterval>::init_by_chunks(std::size_t nb_chunks, Func&& init_chunk)
+    {
+        std::vector<LevelCellArray> parts(nb_chunks, LevelCellArray(m_level));
+
+        parallel::for_each_index(nb_chunks,
+                                 [&](std::size_t c)
+                                 {
+                                     init_chunk(parts[c], c);
+                                 });
+
+        concatenate(parts);
+        update_caches();
+    }
+
+    /**
+     * Concatenate arrays covering increasing positions along the last
+     * dimension. The destination of each part is given by prefix sums on the
+     * sizes of the parts, so that they are copied concurrently.
+     */
+    template <std::size_t Dim, class TInterval>
+    inline void LevelCellArray<Dim, TInterval>::concatenate(const std::vector<LevelCellArray>& parts)
+    {
+        std::vector<const LevelCellArray*> non_empty_parts;
+        for (const auto& part : parts)
+        {
+            if (!part.m_cells[dim - 1].empty())
+            {
+                non_empty_parts.push_back(&part);
+            }
+        }
+        const std::size_t nb_parts = non_empty_parts.size();
+        if (nb_parts == 0)
+        {
+            return;
+        }
+
+        // Along the last dimension, the first interval of a part continues
+        // the last interval of the previous one when they are adjacent.
+        std::vector<std::size_t> merged(nb_parts, 0);
+        std::vector<std::array<std::size_t, dim>> cells_start(nb_parts + 1);
+        std::vector<std::array<std::size_t, dim>> points_start(nb_parts + 1);
+        cells_start[0].fill(0);
+        points_start[0].fill(0);
+
+        for (std::size_t p = 0; p < nb_parts; ++p)
+        {
+            const auto& part = *non_empty_parts[p];
+            if (p > 0 && non_empty_parts[p - 1]->m_cells[dim - 1].back().end == part.m_cells[dim - 1].front().start)
+            {
+                merged[p] = 1;
+            }
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                cells_start[p + 1][d] = cells_start[p][d] + part.m_cells[d].size() - (d == dim - 1 ? merged[p] : 0);
+                // number of positions along the dimension d
+                points_start[p + 1][d] = points_start[p][d] + (d > 0 ? part.m_offsets[d - 1].size() - 1 : 0);
+            }
+        }
+
+        for (std::size_t d = 0; d < dim; ++d)
+        {
+            m_cells[d].resize(cells_start[nb_parts][d]);
+        }
+        for (std::size_t d = 0; d < dim - 1; ++d)
+        {
+            m_offsets[d].resize(points_start[nb_parts][d + 1] + 1);
+        }
+
+        parallel::for_each_index(nb_parts,
+                                 [&](std::size_t p)
+                                 {
+                                     const auto& part = *non_empty_parts[p];
+                                     for (std::size_t d = 0; d < dim; ++d)
+                                     {
+                                         const std::size_t first = d == dim - 1 ? merged[p] : 0;
+                                         const auto index_shift  = static_cast<index_t>(points_start[p][d]);
+                                         for (std::size_t k = first; k < part.m_cells[d].size(); ++k)
+                                         {
+                                             auto& interval = m_cells[d][cells_start[p][d] + k - first];
+                                             interval       = part.m_cells[d][k];
+                                             interval.index += index_shift;
+                                         }
+                                     }
+                                     for (std::size_t d = 0; d < dim - 1; ++d)
+                                     {
+                                         for (std::size_t k = 0; k + 1 < part.m_offsets[d].size(); ++k)
+                                         {
+                                             m_offsets[d][points_start[p][d + 1] + k] = part.m_offsets[d][k] + cells_start[p][d];
+                                         }
+                                     }
+                                 });
+
+        for (std::size_t p = 1; p < nb_parts; ++p)
+        {
+            if (merged[p])
+            {
+                m_cells[dim - 1][cells_start[p][dim - 1] - 1].end = non_empty_parts[p]->m_cells[dim - 1].front().end;
+            }
+        }
+        for (std::size_t d = 0; d < dim - 1; ++d)
+        {
+            m_offsets[d].back() = m_cells[d].size();
+        }
+    }
+
     template <std::size_t Dim, class TInterval>
     inline void LevelCellArray<Dim, TInterval>::init_from_box(const Box<value_t, dim>& box)
     {
@@ -1048,6 +1694,7 @@ namespace samurai
         {
             m_cells[0][i] = {start_pt[0], end_pt[0], static_cast<index_t>(i * dimensions[0]) - start_pt[0]};
         }
+        update_caches();
     }
 
     template <std::size_t Dim, class TInterval>
@@ -1126,6 +1773,11 @@ namespace samurai
             return false;
         }
 
+        if (lca_1.hash() != lca_2.hash())
+        {
+            return false;
+        }
+
         for (std::size_t i = 0; i < Dim; ++i)
         {
             if (lca_1[i] != lca_2[i])
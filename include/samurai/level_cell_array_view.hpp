@@ -0,0 +1,271 @@
+// Copyright 2018-2025 the samurai's authors
+// SPDX-License-Identifier:  BSD-3-Clause
+
+#pragma once
+
+#include <array>
+#include <numeric>
+#include <span>
+
+#include "cell.hpp"
+#include "level_cell_array.hpp"
+#include "samurai_config.hpp"
+
+namespace samurai
+{
+    ///////////////////////////////////
+    // LevelCellArrayView definition //
+    ///////////////////////////////////
+
+    /** @class LevelCellArrayView
+     *  @brief Read-only view with the layout of a LevelCellArray over buffers it does not own.
+     *
+     * The intervals and the offsets are given as spans: the view can be built
+     * over a LevelCellArray, a received MPI buffer or a memory-mapped file
+     * without copying them. The buffers must outlive the view.
+     *
+     * A view can be used wherever a LevelCellArray is read by the subset
+     * operators (intersection, union_, translate, ...) and by for_each_interval
+     * and for_each_cell.
+     *
+     * @tparam Dim        The dimension.
+     * @tparam TInterval  The interval type.
+     */
+    template <std::size_t Dim, class TInterval = default_config::interval_t>
+    class LevelCellArrayView
+    {
+      public:
+
+        static constexpr auto dim = Dim;
+        using interval_t          = TInterval;
+        using cell_t              = Cell<dim, interval_t>;
+        using index_t             = typename interval_t::index_t;
+        using value_t             = typename interval_t::value_t;
+        using coords_t            = typename cell_t::coords_t;
+        using lca_type            = LevelCellArray<Dim, TInterval>;
+
+        using interval_span_t = std::span<const interval_t>;
+        using offset_span_t   = std::span<const std::size_t>;
+
+        LevelCellArrayView() = default;
+        explicit LevelCellArrayView(const lca_type& lca);
+        explicit LevelCellArrayView(const lca_type&& lca) = delete;
+        LevelCellArrayView(std::size_t level,
+                           const std::array<interval_span_t, dim>& cells,
+                           const std::array<offset_span_t, dim - 1>& offsets,
+                           const coords_t& origin_point,
+                           double scaling_factor);
+
+        const interval_span_t& operator[](std::size_t d) const;
+        const offset_span_t& offsets(std::size_t d) const;
+
+        std::size_t level() const;
+
+        bool empty() const;
+
+        auto shape() const;
+        std::size_t nb_intervals() const;
+        std::size_t nb_cells() const;
+
+        auto& origin_point() const;
+        double scaling_factor() const;
+        double cell_length() const;
+
+      private:
+
+        std::array<interval_span_t, dim> m_cells;
+        std::array<offset_span_t, dim - 1> m_offsets;
+        std::size_t m_level = 0;
+        coords_t m_origin_point;
+        double m_scaling_factor = 1;
+    };
+
+    ///////////////////////////////////////
+    // LevelCellArrayView implementation //
+    ///////////////////////////////////////
+
+    template <std::size_t Dim, class TInterval>
+    inline LevelCellArrayView<Dim, TInterval>::LevelCellArrayView(const lca_type& lca)
+        : m_level(lca.level())
+        , m_origin_point(lca.origin_point())
+        , m_scaling_factor(lca.scaling_factor())
+    {
+        for (std::size_t d = 0; d < dim; ++d)
+        {
+            m_cells[d] = interval_span_t(lca[d]);
+        }
+        for (std::size_t d = 1; d < dim; ++d)
+        {
+            m_offsets[d - 1] = offset_span_t(lca.offsets(d));
+        }
+    }
+
+    /**
+     * View over raw buffers laid out as in a LevelCellArray.
+     *
+     * @param level The level of the cells.
+     * @param cells The intervals in each direction.
+     * @param offsets The offsets for the directions > 0 (offsets[d - 1] is returned by offsets(d)),
+     *                with their trailing sentinel.
+     * @param origin_point The origin point of the mesh.
+     * @param scaling_factor The scaling factor of the mesh.
+     */
+    template <std::size_t Dim, class TInterval>
+    inline LevelCellArrayView<Dim, TInterval>::LevelCellArrayView(std::size_t level,
+                                                                  const std::array<interval_span_t, dim>& cells,
+                                                                  const std::array<offset_span_t, dim - 1>& offsets,
+                                                                  const coords_t& origin_point,
+                                                                  double scaling_factor)
+        : m_cells(cells)
+        , m_offsets(offsets)
+        , m_level(level)
+        , m_origin_point(origin_point)
+        , m_scaling_factor(scaling_factor)
+    {
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline auto LevelCellArrayView<Dim, TInterval>::operator[](std::size_t d) const -> const interval_span_t&
+    {
+        return m_cells[d];
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline auto LevelCellArrayView<Dim, TInterval>::offsets(std::size_t d) const -> const offset_span_t&
+    {
+        assert(d > 0);
+        return m_offsets[d - 1];
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline std::size_t LevelCellArrayView<Dim, TInterval>::level() const
+    {
+        return m_level;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline bool LevelCellArrayView<Dim, TInterval>::empty() const
+    {
+        return m_cells[0].empty();
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline auto LevelCellArrayView<Dim, TInterval>::shape() const
+    {
+        std::array<std::size_t, dim> output;
+        for (std::size_t d = 0; d < dim; ++d)
+        {
+            output[d] = m_cells[d].size();
+        }
+        return output;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline std::size_t LevelCellArrayView<Dim, TInterval>::nb_intervals() const
+    {
+        std::size_t s = 0;
+        for (std::size_t d = 0; d < dim; ++d)
+        {
+            s += m_cells[d].size();
+        }
+        return s;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline std::size_t LevelCellArrayView<Dim, TInterval>::nb_cells() const
+    {
+        auto op = [](std::size_t i, const auto& interval)
+        {
+            return i + interval.size();
+        };
+
+        return std::accumulate(m_cells[0].begin(), m_cells[0].end(), std::size_t(0), op);
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline auto& LevelCellArrayView<Dim, TInterval>::origin_point() const
+    {
+        return m_origin_point;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline double LevelCellArrayView<Dim, TInterval>::scaling_factor() const
+    {
+        return m_scaling_factor;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline double LevelCellArrayView<Dim, TInterval>::cell_length() const
+    {
+        return samurai::cell_length(m_scaling_factor, m_level);
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline auto make_level_cell_array_view(const LevelCellArray<Dim, TInterval>& lca)
+    {
+        return LevelCellArrayView<Dim, TInterval>(lca);
+    }
+
+    ////////////////////////////////////////
+    // for_each_* on a LevelCellArrayView //
+    ////////////////////////////////////////
+
+    namespace detail
+    {
+        template <std::size_t d, class LCA, class coord_t, class Func>
+        inline void for_each_interval_rec(const LCA& lca, std::size_t first, std::size_t last, coord_t& index, Func& f)
+        {
+            if constexpr (d == 0)
+            {
+                for (std::size_t i = first; i < last; ++i)
+                {
+                    f(lca.level(), lca[0][i], index);
+                }
+            }
+            else
+            {
+                const auto& offsets = lca.offsets(d);
+                for (std::size_t j = first; j < last; ++j)
+                {
+                    const auto& interval = lca[d][j];
+                    for (auto y = interval.start; y < interval.end; ++y)
+                    {
+                        index[d - 1] = y;
+                        auto io      = static_cast<std::size_t>(interval.index + y);
+                        for_each_interval_rec<d - 1>(lca, offsets[io], offsets[io + 1], index, f);
+                    }
+                }
+            }
+        }
+    }
+
+    template <std::size_t dim, class TInterval, class Func>
+    inline void for_each_interval(const LevelCellArrayView<dim, TInterval>& view, Func&& f)
+    {
+        xt::xtensor_fixed<typename TInterval::value_t, xt::xshape<dim - 1>> index;
+        detail::for_each_interval_rec<dim - 1>(view, 0, view[dim - 1].size(), index, f);
+    }
+
+    template <std::size_t dim, class TInterval, class Func>
+    inline void for_each_cell(const LevelCellArrayView<dim, TInterval>& view, Func&& f)
+    {
+        using cell_t        = Cell<dim, TInterval>;
+        using index_value_t = typename cell_t::value_t;
+        typename cell_t::indices_t index;
+
+        for_each_interval(view,
+                          [&](std::size_t level, const auto& interval, const auto& index_yz)
+                          {
+                              for (std::size_t d = 0; d < dim - 1; ++d)
+                              {
+                                  index[d + 1] = index_yz[d];
+                              }
+                              for (index_value_t i = interval.start; i < interval.end; ++i)
+                              {
+                                  index[0] = i;
+                                  cell_t cell{view.origin_point(), view.scaling_factor(), level, index, interval.index + i};
+                                  f(cell);
+                              }
+                          });
+    }
+} // namespace samurai
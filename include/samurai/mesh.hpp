@@ -3,16 +3,22 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <set>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 
 #include <fmt/format.h>
 
+#include "arguments.hpp"
 #include "box.hpp"
 #include "cell_array.hpp"
 #include "cell_list.hpp"
 #include "static_algorithm.hpp"
 #include "subset/node.hpp"
+#include "subset/plan.hpp"
 
 #ifdef SAMURAI_WITH_MPI
 #include <boost/serialization/vector.hpp>
@@ -55,6 +61,29 @@ namespace samurai
         }
     };
 
+    namespace detail
+    {
+        /**
+         * Cell list used to build the meshes of a configuration.
+         *
+         * CellList (nested std::map) by default, a configuration can opt in to
+         * another builder by defining cl_type, e.g.
+         *
+         *     using cl_type = FlatCellList<dim, interval_t, max_refinement_level>;
+         */
+        template <class Config, class = void>
+        struct config_cell_list
+        {
+            using type = CellList<Config::dim, typename Config::interval_t, Config::max_refinement_level>;
+        };
+
+        template <class Config>
+        struct config_cell_list<Config, std::void_t<typename Config::cl_type>>
+        {
+            using type = typename Config::cl_type;
+        };
+    } // namespace detail
+
     template <class D, class Config>
     class Mesh_base
     {
@@ -72,7 +101,7 @@ namespace samurai
         using index_t    = typename interval_t::index_t;
 
         using cell_t   = Cell<dim, interval_t>;
-        using cl_type  = CellList<dim, interval_t, max_refinement_level>;
+        using cl_type  = typename detail::config_cell_list<Config>::type;
         using lcl_type = typename cl_type::lcl_type;
 
         using ca_type  = CellArray<dim, interval_t, max_refinement_level>;
@@ -86,6 +115,8 @@ namespace samurai
 
         using mpi_subdomain_t = MPI_Subdomain<D>;
 
+        using subset_plan_t = SubsetPlan<dim, interval_t>;
+
         std::size_t nb_cells(mesh_id_t mesh_id = mesh_id_t::reference) const;
         std::size_t nb_cells(std::size_t level, mesh_id_t mesh_id = mesh_id_t::reference) const;
 
@@ -114,6 +145,11 @@ namespace samurai
 
         void swap(Mesh_base& mesh) noexcept;
 
+        std::size_t generation() const;
+
+        template <class Set>
+        const subset_plan_t& subset_plan(std::string_view name, std::size_t level, Set&& set) const;
+
         template <typename... T, typename = std::enable_if_t<std::conjunction_v<std::is_convertible<T, value_t>...>, void>>
         const interval_t& get_interval(std::size_t level, const interval_t& interval, T... index) const;
         template <class E>
@@ -175,8 +211,13 @@ namespace samurai
         void construct_subdomain();
         void construct_domain();
         void construct_union();
+        void construct_union(std::size_t finest_level);
         void update_sub_mesh();
+        void update_sub_mesh(const self_type& ref_mesh);
+        void update_reference_index();
         void renumbering();
+        void renumbering(const self_type& ref_mesh);
+        void construct_from_reference(const self_type& ref_mesh);
 
         void find_neighbourhood();
 
@@ -194,6 +235,8 @@ namespace samurai
         ca_type m_union;
         // std::vector<int> m_neighbouring_ranks;
         std::vector<mpi_subdomain_t> m_mpi_neighbourhood;
+        std::size_t m_generation = 0;
+        mutable SubsetPlanCache<dim, interval_t> m_subset_plans;
 
 #ifdef SAMURAI_WITH_MPI
         friend class boost::serialization::access;
@@ -359,11 +402,7 @@ namespace samurai
     {
         m_cells[mesh_id_t::cells] = ca;
 
-        construct_subdomain();
-        construct_union();
-        update_sub_mesh();
-        renumbering();
-        update_mesh_neighbour();
+        construct_from_reference(ref_mesh);
 
         set_origin_point(ref_mesh.origin_point());
         set_scaling_factor(ref_mesh.scaling_factor());
@@ -380,11 +419,7 @@ namespace samurai
     {
         m_cells[mesh_id_t::cells] = {cl, false};
 
-        construct_subdomain();
-        construct_union();
-        update_sub_mesh();
-        renumbering();
-        update_mesh_neighbour();
+        construct_from_reference(ref_mesh);
 
         set_origin_point(ref_mesh.origin_point());
         set_scaling_factor(ref_mesh.scaling_factor());
@@ -399,12 +434,13 @@ namespace samurai
     template <class D, class Config>
     inline std::size_t Mesh_base<D, Config>::max_nb_cells(std::size_t level) const
     {
-        if (m_cells[mesh_id_t::reference][level][0].empty())
+        // the last x-interval does not hold the largest index with the Morton ordering
+        index_t end = 0;
+        for (const auto& i : m_cells[mesh_id_t::reference][level][0])
         {
-            return 0;
+            end = std::max(end, i.index + static_cast<index_t>(i.end));
         }
-        auto last_xinterval = m_cells[mesh_id_t::reference][level][0].back();
-        return static_cast<std::size_t>(static_cast<index_t>(last_xinterval.start) + last_xinterval.index) + last_xinterval.size();
+        return static_cast<std::size_t>(end);
     }
 
     template <class D, class Config>
@@ -621,6 +657,47 @@ namespace samurai
         swap(m_union, mesh.m_union);
         swap(m_max_level, mesh.m_max_level);
         swap(m_min_level, mesh.m_min_level);
+        swap(m_generation, mesh.m_generation);
+        swap(m_subset_plans, mesh.m_subset_plans);
+    }
+
+    /**
+     * Identifier of the current state of the mesh: it changes each time the
+     * mesh is built or its neighbourhood is updated, and is never shared by two
+     * different meshes.
+     */
+    template <class D, class Config>
+    inline std::size_t Mesh_base<D, Config>::generation() const
+    {
+        return m_generation;
+    }
+
+    /**
+     * Return the plan of a subset expression over this mesh, evaluated the
+     * first time it is requested for the current version of the mesh.
+     *
+     * The version is the generation of the mesh combined with the hashes of
+     * its cells, the domain and the subdomain: the plans are also evaluated
+     * again when the cells are modified through the mutable accessors, which
+     * don't change the generation. These hashes are cached by the arrays, so
+     * the check is cheap while the cells are unchanged.
+     *
+     * @param name The name of the expression; with level, it identifies the plan.
+     * @param level The level of the expression.
+     * @param set The expression, only evaluated when the plan is not known.
+     */
+    template <class D, class Config>
+    template <class Set>
+    inline auto Mesh_base<D, Config>::subset_plan(std::string_view name, std::size_t level, Set&& set) const -> const subset_plan_t&
+    {
+        std::size_t version = m_generation;
+        for (std::size_t id = 0; id < mesh_t::size; ++id)
+        {
+            ::hash_combine(version, m_cells[id].hash());
+        }
+        ::hash_combine(version, m_domain.hash());
+        ::hash_combine(version, m_subdomain.hash());
+        return m_subset_plans.get({name, level}, version, std::forward<Set>(set));
     }
 
     template <class D, class Config>
@@ -629,10 +706,40 @@ namespace samurai
         this->derived_cast().update_sub_mesh_impl();
     }
 
+    /**
+     * Same as update_sub_mesh, for the meshes which can reuse the sub-meshes
+     * of the mesh they are built from (update_sub_mesh_impl(ref_mesh)).
+     */
+    template <class D, class Config>
+    inline void Mesh_base<D, Config>::update_sub_mesh(const self_type& ref_mesh)
+    {
+        if constexpr (requires(derived_type& mesh) { mesh.update_sub_mesh_impl(ref_mesh); })
+        {
+            this->derived_cast().update_sub_mesh_impl(ref_mesh);
+        }
+        else
+        {
+            update_sub_mesh();
+        }
+    }
+
+    template <class D, class Config>
+    inline void Mesh_base<D, Config>::update_reference_index()
+    {
+        if (args::morton_ordering) // cppcheck-suppress knownConditionTrueFalse
+        {
+            m_cells[mesh_id_t::reference].update_index_morton();
+        }
+        else
+        {
+            m_cells[mesh_id_t::reference].update_index();
+        }
+    }
+
     template <class D, class Config>
     inline void Mesh_base<D, Config>::renumbering()
     {
-        m_cells[mesh_id_t::reference].update_index();
+        update_reference_index();
 
         for (std::size_t id = 0; id < static_cast<std::size_t>(mesh_id_t::count); ++id)
         {
@@ -640,18 +747,129 @@ namespace samurai
 
             if (mt != mesh_id_t::reference)
             {
-                for_each_interval(m_cells[mt],
-                                  [&](std::size_t level, auto& i, auto& index)
-                                  {
-                                      i.index = m_cells[mesh_id_t::reference][level].get_interval(i, index).index;
-                                  });
+                for (std::size_t level = 0; level <= max_refinement_level; ++level)
+                {
+                    const auto& reference = m_cells[mesh_id_t::reference][level];
+                    m_cells[mt][level].update_index(
+                        [&](const auto& i, const auto& index)
+                        {
+                            return reference.get_interval(i, index).index;
+                        });
+                }
+            }
+        }
+    }
+
+    /**
+     * Renumbering of a mesh built from ref_mesh: the levels whose reference
+     * cells are unchanged only shift the indices of ref_mesh instead of
+     * searching them in the reference mesh.
+     */
+    template <class D, class Config>
+    inline void Mesh_base<D, Config>::renumbering(const self_type& ref_mesh)
+    {
+        update_reference_index();
+        const auto& reference     = m_cells[mesh_id_t::reference];
+        const auto& old_reference = ref_mesh.m_cells[mesh_id_t::reference];
+
+        for (std::size_t level = 0; level <= max_refinement_level; ++level)
+        {
+            const bool same_reference = !reference[level].empty() && reference[level].has_same_cells(old_reference[level]);
+            // Number of cells added or removed on the coarser levels
+            const index_t shift = same_reference ? reference[level][0].front().index - old_reference[level][0].front().index : 0;
+
+            for (std::size_t id = 0; id < static_cast<std::size_t>(mesh_id_t::count); ++id)
+            {
+                auto mt = static_cast<mesh_id_t>(id);
+
+                if (mt != mesh_id_t::reference)
+                {
+                    auto& lca           = m_cells[mt][level];
+                    const auto& old_lca = ref_mesh.m_cells[mt][level];
+                    if (same_reference && lca.has_same_cells(old_lca))
+                    {
+                        std::size_t position = 0;
+                        lca.update_index(
+                            [&](const auto&, const auto&)
+                            {
+                                return old_lca[0][position++].index + shift;
+                            });
+                    }
+                    else
+                    {
+                        lca.update_index(
+                            [&](const auto& i, const auto& index)
+                            {
+                                return reference[level].get_interval(i, index).index;
+                            });
+                    }
+                }
             }
         }
     }
 
+    /**
+     * Construction of the sub-meshes from the cells and the mesh they come
+     * from (typically the mesh before an adaptation step).
+     *
+     * If the cells are unchanged, the sub-meshes of ref_mesh are reused as is.
+     * Otherwise, the union cells above the finest modified level and the
+     * indices of the unmodified levels are taken from ref_mesh, and the
+     * derived mesh may rebuild its sub-meshes only around the modified cells
+     * (see update_sub_mesh); the rest is rebuilt.
+     */
+    template <class D, class Config>
+    inline void Mesh_base<D, Config>::construct_from_reference(const self_type& ref_mesh)
+    {
+        const auto& cells     = m_cells[mesh_id_t::cells];
+        const auto& old_cells = ref_mesh.m_cells[mesh_id_t::cells];
+
+        bool unchanged             = true;
+        std::size_t finest_changed = 0;
+        for (std::size_t level = 0; level <= max_refinement_level; ++level)
+        {
+            if (!cells[level].has_same_cells(old_cells[level]))
+            {
+                unchanged      = false;
+                finest_changed = level;
+            }
+        }
+
+#ifndef SAMURAI_WITH_MPI
+        // With MPI, update_mesh_neighbour must be called by all the processes
+        if (unchanged)
+        {
+            m_cells     = ref_mesh.m_cells;
+            m_subdomain = ref_mesh.m_subdomain;
+            m_union     = ref_mesh.m_union;
+            // update_mesh_neighbour is skipped: the mesh still needs its own generation
+            m_generation = detail::new_mesh_generation();
+            return;
+        }
+#endif
+
+        construct_subdomain();
+        if (unchanged || finest_changed < m_max_level)
+        {
+            // union_cells[level] only depends on the cells of the finer levels
+            m_union = ref_mesh.m_union;
+            construct_union(unchanged ? 0 : finest_changed);
+        }
+        else
+        {
+            construct_union();
+        }
+        update_sub_mesh(ref_mesh);
+        renumbering(ref_mesh);
+        update_mesh_neighbour();
+    }
+
     template <class D, class Config>
     inline void Mesh_base<D, Config>::update_mesh_neighbour()
     {
+        // called once the cells are built: the plans of the previous mesh are obsolete
+        m_generation = detail::new_mesh_generation();
+
 #ifdef SAMURAI_WITH_MPI
         // send/recv the meshes of the neighbouring subdomains
         mpi::communicator world;
@@ -769,7 +987,7 @@ namespace samurai
         // lcl_type lcl = {m_cells[mesh_id_t::cells].max_level()};
         lcl_type lcl = {m_max_level};
 
-        for_each_interval(m_cells[mesh_id_t::cells],
+        for_each_interval(std::as_const(m_cells[mesh_id_t::cells]),
                           [&](std::size_t level, const auto& i, const auto& index)
                           {
                               std::size_t shift = m_max_level - level;
@@ -797,7 +1015,6 @@ namespace samurai
     template <class D, class Config>
     inline void Mesh_base<D, Config>::construct_union()
     {
-        std::size_t min_lvl = m_min_level;
         std::size_t max_lvl = m_max_level;
 
         // Construction of union cells
@@ -814,18 +1031,19 @@ namespace samurai
         // FIX: cppcheck false positive ?
         // cppcheck-suppress redundantAssignment
         m_union[max_lvl] = {max_lvl};
-        for (std::size_t level = max_lvl; level >= ((min_lvl == 0) ? 1 : min_lvl); --level)
-        {
-            lcl_type lcl{level - 1};
-            auto expr = union_(this->m_cells[mesh_id_t::cells][level], m_union[level]).on(level - 1);
+        construct_union(max_lvl);
+    }
 
-            expr(
-                [&](const auto& interval, const auto& index_yz)
-                {
-                    lcl[index_yz].add_interval(interval);
-                });
+    /// Construction of the union cells below finest_level, m_union[finest_level] must be up to date.
+    template <class D, class Config>
+    inline void Mesh_base<D, Config>::construct_union(std::size_t finest_level)
+    {
+        std::size_t min_lvl = m_min_level;
 
-            m_union[level - 1] = {lcl};
+        for (std::size_t level = finest_level; level >= ((min_lvl == 0) ? 1 : min_lvl); --level)
+        {
+            // the intervals of the subset are sorted: they are appended directly
+            m_union[level - 1] = lca_type(union_(this->m_cells[mesh_id_t::cells][level], m_union[level]).on(level - 1));
         }
     }
 
@@ -842,7 +1060,7 @@ namespace samurai
         {
             if (i != static_cast<std::size_t>(world.rank()))
             {
-                auto set = intersection(nestedExpand(m_subdomain, 1), neighbours[i]);
+                auto set = intersection(expand(m_subdomain, 1), neighbours[i]);
                 if (!set.empty())
                 {
                     set_neighbours.insert(static_cast<int>(i));
@@ -852,12 +1070,12 @@ namespace samurai
                     if (m_periodic[d])
                     {
                         auto shift             = get_periodic_shift(m_domain, m_subdomain.level(), d);
-                        auto periodic_set_left = intersection(nestedExpand(m_subdomain, 1), translate(neighbours[i], -shift));
+                        auto periodic_set_left = intersection(expand(m_subdomain, 1), translate(neighbours[i], -shift));
                         if (!periodic_set_left.empty())
                         {
                             set_neighbours.insert(static_cast<int>(i));
                         }
-                        auto periodic_set_right = intersection(nestedExpand(m_subdomain, 1), translate(neighbours[i], shift));
+                        auto periodic_set_right = intersection(expand(m_subdomain, 1), translate(neighbours[i], shift));
                         if (!periodic_set_right.empty())
                         {
                             set_neighbours.insert(static_cast<int>(i));
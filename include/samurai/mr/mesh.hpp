@@ -90,9 +90,14 @@ namespace samurai
                double scaling_factor = 0);
 
         void update_sub_mesh_impl();
+        void update_sub_mesh_impl(const base_type& ref_mesh);
 
         template <typename... T>
         xt::xtensor<bool, 1> exists(mesh_id_t type, std::size_t level, interval_t interval, T... index) const;
+
+      private:
+
+        void update_all_and_proj_cells(cl_type& cell_list);
     };
 
     template <class Config>
@@ -143,20 +148,8 @@ namespace samurai
     template <class Config>
     inline void MRMesh<Config>::update_sub_mesh_impl()
     {
-#ifdef SAMURAI_WITH_MPI
-        mpi::communicator world;
-        // cppcheck-suppress redundantInitialization
-        auto max_level = mpi::all_reduce(world, this->cells()[mesh_id_t::cells].max_level(), mpi::maximum<std::size_t>());
-        // cppcheck-suppress redundantInitialization
-        auto min_level = mpi::all_reduce(world, this->cells()[mesh_id_t::cells].min_level(), mpi::minimum<std::size_t>());
-        cl_type cell_list;
-#else
-        // cppcheck-suppress redundantInitialization
-        auto max_level = this->cells()[mesh_id_t::cells].max_level();
-        // cppcheck-suppress redundantInitialization
-        auto min_level = this->cells()[mesh_id_t::cells].min_level();
         cl_type cell_list;
-#endif
+
         // Construction of ghost cells
         // ===========================
         //
@@ -172,7 +165,7 @@ namespace samurai
         // level 0 |.......|-------|.......|       |.......|-------|.......|
         //
         for_each_interval(
-            this->cells()[mesh_id_t::cells],
+            std::as_const(this->cells()[mesh_id_t::cells]),
             [&](std::size_t level, const auto& interval, const auto& index_yz)
             {
                 lcl_type& lcl = cell_list[level];
@@ -185,6 +178,90 @@ namespace samurai
             });
         this->cells()[mesh_id_t::cells_and_ghosts] = {cell_list, false};
 
+        update_all_and_proj_cells(cell_list);
+    }
+
+    /**
+     * Same as update_sub_mesh_impl for a mesh built from ref_mesh, whose
+     * cells_and_ghosts are reused: they are the cells dilated by
+     * max_stencil_width in every direction, so they can only change at this
+     * distance of the cells which were added or removed. At each level, only
+     * the ghosts around these cells are computed again, unless more than a
+     * quarter of the cells changed.
+     *
+     * The other sub-meshes depend on the union cells of all the finer levels
+     * and on the periodic and MPI neighbours: they are rebuilt entirely.
+     */
+    template <class Config>
+    inline void MRMesh<Config>::update_sub_mesh_impl(const base_type& ref_mesh)
+    {
+        constexpr auto width                 = static_cast<std::size_t>(config::max_stencil_width);
+        constexpr std::size_t fallback_ratio = 4;
+
+        const auto& cells      = this->cells()[mesh_id_t::cells];
+        const auto& old_cells  = ref_mesh[mesh_id_t::cells];
+        const auto& old_ghosts = ref_mesh[mesh_id_t::cells_and_ghosts];
+        auto& ghosts           = this->cells()[mesh_id_t::cells_and_ghosts];
+
+        cl_type cell_list;
+        for (std::size_t level = 0; level <= config::max_refinement_level; ++level)
+        {
+            if (cells[level].has_same_cells(old_cells[level]))
+            {
+                // the indices are given by the renumbering
+                ghosts[level] = old_ghosts[level];
+            }
+            else if (cells[level].empty())
+            {
+                ghosts[level] = {level};
+            }
+            else
+            {
+                const lca_type changed(union_(difference(cells[level], old_cells[level]), difference(old_cells[level], cells[level])));
+                if (changed.nb_cells() * fallback_ratio > cells[level].nb_cells())
+                {
+                    ghosts[level] = lca_type(expand(cells[level], width));
+                }
+                else
+                {
+                    // the ghosts in region are the ones of the cells at a distance of at most width
+                    const lca_type region(expand(changed, width));
+                    const lca_type near_cells(intersection(cells[level], expand(region, width)));
+                    ghosts[level] = lca_type(
+                        union_(difference(old_ghosts[level], region), intersection(expand(near_cells, width), region)));
+                }
+            }
+
+            lcl_type& lcl = cell_list[level];
+            for_each_interval(std::as_const(ghosts[level]),
+                              [&](auto, const auto& interval, const auto& index_yz)
+                              {
+                                  lcl[index_yz].add_interval(interval);
+                              });
+        }
+
+        update_all_and_proj_cells(cell_list);
+    }
+
+    /**
+     * Construction of all_cells and proj_cells from the cells, the union
+     * cells and the ghost cells in cell_list.
+     */
+    template <class Config>
+    inline void MRMesh<Config>::update_all_and_proj_cells(cl_type& cell_list)
+    {
+#ifdef SAMURAI_WITH_MPI
+        mpi::communicator world;
+        // cppcheck-suppress redundantInitialization
+        auto max_level = mpi::all_reduce(world, this->cells()[mesh_id_t::cells].max_level(), mpi::maximum<std::size_t>());
+        // cppcheck-suppress redundantInitialization
+        auto min_level = mpi::all_reduce(world, this->cells()[mesh_id_t::cells].min_level(), mpi::minimum<std::size_t>());
+#else
+        // cppcheck-suppress redundantInitialization
+        auto max_level = this->cells()[mesh_id_t::cells].max_level();
+        // cppcheck-suppress redundantInitialization
+        auto min_level = this->cells()[mesh_id_t::cells].min_level();
+#endif
         // Add cells for the MRA
         if (this->max_level() != this->min_level())
         {
@@ -383,7 +460,7 @@ namespace samurai
             for (std::size_t level = 0; level < max_level; ++level)
             {
                 lcl_type& lcl = cell_list[level + 1];
-                lcl_type lcl_proj{level};
+                lca_type lca_proj{level};
                 auto expr = intersection(this->cells()[mesh_id_t::all_cells][level], this->get_union()[level]);
 
                 expr(
@@ -394,10 +471,11 @@ namespace samurai
                             {
                                 lcl[(index_yz << 1) + s].add_interval(interval << 1);
                             });
-                        lcl_proj[index_yz].add_interval(interval);
+                        // the intervals are given in order: no LevelCellList is needed
+                        lca_proj.add_interval_back(interval, index_yz);
                     });
                 this->cells()[mesh_id_t::all_cells][level + 1] = lcl;
-                this->cells()[mesh_id_t::proj_cells][level]    = lcl_proj;
+                this->cells()[mesh_id_t::proj_cells][level]    = lca_proj;
             }
             this->update_neighbour_subdomain();
             this->update_meshid_neighbour(mesh_id_t::all_cells);
@@ -406,8 +484,8 @@ namespace samurai
             {
                 for (std::size_t level = 0; level <= this->max_level(); ++level)
                 {
-                    auto expr = intersection(nestedExpand(self(this->subdomain()).on(level), config::ghost_width),
-                                             neighbour.mesh[mesh_id_t::reference][level]);
+                    auto expanded_subdomain = expand(self(this->subdomain()).on(level), static_cast<std::size_t>(config::ghost_width));
+                    auto expr               = intersection(expanded_subdomain, neighbour.mesh[mesh_id_t::reference][level]);
                     expr(
                         [&](const auto& interval, const auto& index_yz)
                         {
@@ -419,7 +497,7 @@ namespace samurai
                         if (this->is_periodic(d))
                         {
                             auto domain_shift = get_periodic_shift(this->domain(), level, d);
-                            auto expr_left    = intersection(nestedExpand(self(this->subdomain()).on(level), config::ghost_width),
+                            auto expr_left    = intersection(expanded_subdomain,
                                                           translate(neighbour.mesh[mesh_id_t::reference][level], -domain_shift));
                             expr_left(
                                 [&](const auto& interval, const auto& index_yz)
@@ -428,7 +506,7 @@ namespace samurai
                                     lcl[index_yz].add_interval(interval);
                                 });
 
-                            auto expr_right = intersection(nestedExpand(self(this->subdomain()).on(level), config::ghost_width),
+                            auto expr_right = intersection(expanded_subdomain,
                                                            translate(neighbour.mesh[mesh_id_t::reference][level], domain_shift));
                             expr_right(
                                 [&](const auto& interval, const auto& index_yz)
@@ -128,7 +128,7 @@ namespace samurai
         }
 
         // Construct ghost cells
-        for_each_interval(this->m_cells[mesh_id_t::cells],
+        for_each_interval(std::as_const(this->m_cells[mesh_id_t::cells]),
                           [&](std::size_t level, const auto& interval, const auto& index_yz)
                           {
                               lcl_type& lcl = cell_list[level];
@@ -145,8 +145,8 @@ namespace samurai
         // Construct projection cells
         for (std::size_t level = ((min_level == 0) ? 1 : min_level); level <= max_level; ++level)
         {
-            lca_type& lca = this->m_cells[mesh_id_t::cells][level];
-            lcl_type& lcl = cell_list[level - 1];
+            const lca_type& lca = this->m_cells[mesh_id_t::cells][level];
+            lcl_type& lcl       = cell_list[level - 1];
 
             for_each_interval(lca,
                               [&](std::size_t /*level*/, const auto& interval, const auto& index_yz)
@@ -217,7 +217,7 @@ namespace samurai
         const int cells_to_add = 1; // To be changed according to the numerical scheme
 
         for_each_interval(
-            this->m_cells[mesh_id_t::cells],
+            std::as_const(this->m_cells[mesh_id_t::cells]),
             [&](std::size_t level, const auto& interval, const auto& index_yz)
             {
                 if (level < this->max_level())
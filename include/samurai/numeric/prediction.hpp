@@ -118,7 +118,8 @@ namespace samurai
         template <std::size_t s, class interval_t, class... index_t>
         inline auto operator()(std::integral_constant<std::size_t, s>, std::size_t level, const interval_t& i, const index_t... index)
         {
-            return m_e(level, i, index...);
+            // the sums of the prediction are computed in the accumulation type
+            return accumulation_cast(m_e(level, i, index...));
         }
 
         T m_e;
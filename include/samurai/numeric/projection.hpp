@@ -18,28 +18,33 @@ namespace samurai
 
         INIT_OPERATOR(projection_op_)
 
+        // the mean of the children is computed in the accumulation type
         template <class T1, class T2>
         inline void operator()(Dim<1>, T1& dest, const T2& src) const
         {
-            dest(level, i) = .5 * (src(level + 1, 2 * i) + src(level + 1, 2 * i + 1));
+            dest(level, i) = .5 * (accumulation_cast(src(level + 1, 2 * i)) + accumulation_cast(src(level + 1, 2 * i + 1)));
         }
 
         template <class T1, class T2>
         inline void operator()(Dim<2>, T1& dest, const T2& src) const
         {
             dest(level, i, j) = .25
-                              * (src(level + 1, 2 * i, 2 * j) + src(level + 1, 2 * i, 2 * j + 1) + src(level + 1, 2 * i + 1, 2 * j)
-                                 + src(level + 1, 2 * i + 1, 2 * j + 1));
+                              * (accumulation_cast(src(level + 1, 2 * i, 2 * j)) + accumulation_cast(src(level + 1, 2 * i, 2 * j + 1))
+                                 + accumulation_cast(src(level + 1, 2 * i + 1, 2 * j)) + accumulation_cast(src(level + 1, 2 * i + 1, 2 * j + 1)));
         }
 
         template <class T1, class T2>
         inline void operator()(Dim<3>, T1& dest, const T2& src) const
         {
             dest(level, i, j, k) = .125
-                                 * (src(level + 1, 2 * i, 2 * j, 2 * k) + src(level + 1, 2 * i + 1, 2 * j, 2 * k)
-                                    + src(level + 1, 2 * i, 2 * j + 1, 2 * k) + src(level + 1, 2 * i + 1, 2 * j + 1, 2 * k)
-                                    + src(level + 1, 2 * i, 2 * j, 2 * k + 1) + src(level + 1, 2 * i + 1, 2 * j, 2 * k + 1)
-                                    + src(level + 1, 2 * i, 2 * j + 1, 2 * k + 1) + src(level + 1, 2 * i + 1, 2 * j + 1, 2 * k + 1));
+                                 * (accumulation_cast(src(level + 1, 2 * i, 2 * j, 2 * k))
+                                    + accumulation_cast(src(level + 1, 2 * i + 1, 2 * j, 2 * k))
+                                    + accumulation_cast(src(level + 1, 2 * i, 2 * j + 1, 2 * k))
+                                    + accumulation_cast(src(level + 1, 2 * i + 1, 2 * j + 1, 2 * k))
+                                    + accumulation_cast(src(level + 1, 2 * i, 2 * j, 2 * k + 1))
+                                    + accumulation_cast(src(level + 1, 2 * i + 1, 2 * j, 2 * k + 1))
+                                    + accumulation_cast(src(level + 1, 2 * i, 2 * j + 1, 2 * k + 1))
+                                    + accumulation_cast(src(level + 1, 2 * i + 1, 2 * j + 1, 2 * k + 1)));
         }
     };
 
@@ -0,0 +1,537 @@
+// Copyright 2018-2025 the samurai's authors
+// SPDX-License-Identifier:  BSD-3-Clause
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+#if defined(SAMURAI_WITH_OPENMP) + defined(SAMURAI_WITH_TBB) + defined(SAMURAI_WITH_STD_THREADS) > 1
+#error "Only one parallel backend can be enabled among SAMURAI_WITH_OPENMP, SAMURAI_WITH_TBB and SAMURAI_WITH_STD_THREADS"
+#endif
+
+#if defined(SAMURAI_WITH_OPENMP)
+#include <omp.h>
+#elif defined(SAMURAI_WITH_TBB)
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+#include <tbb/partitioner.h>
+#include <tbb/task_arena.h>
+#elif defined(SAMURAI_WITH_STD_THREADS)
+#include <algorithm>
+#include <condition_variable>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#endif
+
+#if defined(SAMURAI_WITH_OPENMP) || defined(SAMURAI_WITH_TBB) || defined(SAMURAI_WITH_STD_THREADS)
+#define SAMURAI_WITH_PARALLEL
+#endif
+
+/**
+ * The backend used by the Run::Parallel code paths.
+ *
+ * It is chosen at compile time by SAMURAI_WITH_OPENMP, SAMURAI_WITH_TBB or
+ * SAMURAI_WITH_STD_THREADS (the CMake options WITH_OPENMP, WITH_TBB and
+ * WITH_STD_THREADS). Without any of them, everything is sequential.
+ *
+ * A loop started inside another one is sequential: the per-thread buffers
+ * indexed by thread_num() are then never shared by two loop bodies.
+ */
+namespace samurai::parallel
+{
+#if defined(SAMURAI_WITH_OPENMP)
+
+    inline std::size_t max_threads()
+    {
+        return static_cast<std::size_t>(omp_get_max_threads());
+    }
+
+    inline std::size_t thread_num()
+    {
+        return static_cast<std::size_t>(omp_get_thread_num());
+    }
+
+    inline bool in_parallel()
+    {
+        return omp_in_parallel();
+    }
+
+    /// Call f(i) for i in [0, size[, grain consecutive indices being given at once to a thread.
+    template <class Func>
+    inline void for_each_index(std::size_t size, Func&& f, std::size_t grain = 1)
+    {
+        if (in_parallel())
+        {
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                f(i);
+            }
+            return;
+        }
+
+#pragma omp parallel for schedule(dynamic, grain)
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            f(i);
+        }
+    }
+
+    /**
+     * Call f(thread, nb_threads) once on each thread of a parallel region.
+     * Splitting the work by thread gives a static partition: a part is always
+     * given to the same thread, which is the one which touched its memory first.
+     */
+    template <class Func>
+    inline void for_each_thread(Func&& f)
+    {
+        if (in_parallel())
+        {
+            f(std::size_t{0}, std::size_t{1});
+            return;
+        }
+
+#pragma omp parallel
+        {
+            f(thread_num(), static_cast<std::size_t>(omp_get_num_threads()));
+        }
+    }
+
+#elif defined(SAMURAI_WITH_TBB) || defined(SAMURAI_WITH_STD_THREADS)
+
+    namespace detail
+    {
+        inline thread_local bool is_in_parallel = false;
+
+        /// Mark the calling thread as running a loop body.
+        class ParallelScope
+        {
+          public:
+
+            ParallelScope()
+                : m_previous(is_in_parallel)
+            {
+                is_in_parallel = true;
+            }
+
+            ~ParallelScope()
+            {
+                is_in_parallel = m_previous;
+            }
+
+            ParallelScope(const ParallelScope&)            = delete;
+            ParallelScope& operator=(const ParallelScope&) = delete;
+
+          private:
+
+            bool m_previous;
+        };
+    }
+
+    inline bool in_parallel()
+    {
+        return detail::is_in_parallel;
+    }
+
+#if defined(SAMURAI_WITH_TBB)
+
+    inline std::size_t max_threads()
+    {
+        return static_cast<std::size_t>(tbb::this_task_arena::max_concurrency());
+    }
+
+    inline std::size_t thread_num()
+    {
+        const int index = tbb::this_task_arena::current_thread_index();
+        return index < 0 ? 0 : static_cast<std::size_t>(index);
+    }
+
+    /// Call f(i) for i in [0, size[ in the current task arena.
+    template <class Func>
+    inline void for_each_index(std::size_t size, Func&& f, std::size_t grain = 1)
+    {
+        if (in_parallel())
+        {
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                f(i);
+            }
+            return;
+        }
+
+        tbb::parallel_for(tbb::blocked_range<std::size_t>(0, size, grain),
+                          [&](const tbb::blocked_range<std::size_t>& range)
+                          {
+                              detail::ParallelScope scope;
+                              for (std::size_t i = range.begin(); i != range.end(); ++i)
+                              {
+                                  f(i);
+                              }
+                          });
+    }
+
+    /// Call f(thread, nb_threads) for each thread of the current task arena, with a static partition.
+    template <class Func>
+    inline void for_each_thread(Func&& f)
+    {
+        if (in_parallel())
+        {
+            f(std::size_t{0}, std::size_t{1});
+            return;
+        }
+
+        const std::size_t nb_threads = max_threads();
+        tbb::parallel_for(
+            tbb::blocked_range<std::size_t>(0, nb_threads, 1),
+            [&](const tbb::blocked_range<std::size_t>& range)
+            {
+                detail::ParallelScope scope;
+                for (std::size_t t = range.begin(); t != range.end(); ++t)
+                {
+                    f(t, nb_threads);
+                }
+            },
+            tbb::static_partitioner());
+    }
+
+#else
+
+    namespace detail
+    {
+        inline thread_local std::size_t thread_index = 0;
+
+        /**
+         * A fixed set of threads sharing the iterations of one loop at a time
+         * with the calling thread, which has the index 0.
+         *
+         * The number of threads is given by the environment variable
+         * SAMURAI_NUM_THREADS, and is the number of hardware threads by default.
+         */
+        class ThreadPool
+        {
+          public:
+
+            static ThreadPool& instance()
+            {
+                static ThreadPool pool;
+                return pool;
+            }
+
+            ThreadPool(const ThreadPool&)            = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+
+            ~ThreadPool()
+            {
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_stop = true;
+                }
+                m_wake_up.notify_all();
+                for (auto& worker : m_workers)
+                {
+                    worker.join();
+                }
+            }
+
+            std::size_t size() const
+            {
+                return m_workers.size() + 1;
+            }
+
+            /**
+             * Run task(context) on all the threads of the pool.
+             *
+             * @return false if the pool is already used by another thread: the
+             * caller must then do the work alone.
+             */
+            bool run(void (*task)(void*), void* context)
+            {
+                std::unique_lock<std::mutex> run_lock(m_run_mutex, std::try_to_lock);
+                if (!run_lock.owns_lock())
+                {
+                    return false;
+                }
+
+                {
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    m_task    = task;
+                    m_context = context;
+                    m_pending = m_workers.size();
+                    ++m_generation;
+                }
+                m_wake_up.notify_all();
+
+                task(context);
+
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_done.wait(lock,
+                            [this]
+                            {
+                                return m_pending == 0;
+                            });
+                return true;
+            }
+
+          private:
+
+            ThreadPool()
+            {
+                std::size_t nb_threads = std::max(std::size_t{1}, static_cast<std::size_t>(std::thread::hardware_concurrency()));
+                if (const char* env = std::getenv("SAMURAI_NUM_THREADS"))
+                {
+                    nb_threads = std::max(std::size_t{1}, static_cast<std::size_t>(std::stoul(env)));
+                }
+
+                for (std::size_t t = 1; t < nb_threads; ++t)
+                {
+                    m_workers.emplace_back(
+                        [this, t]
+                        {
+                            work(t);
+                        });
+                }
+            }
+
+            void work(std::size_t index)
+            {
+                thread_index               = index;
+                std::size_t old_generation = 0;
+                while (true)
+                {
+                    void (*task)(void*) = nullptr;
+                    void* context       = nullptr;
+                    {
+                        std::unique_lock<std::mutex> lock(m_mutex);
+                        m_wake_up.wait(lock,
+                                       [&]
+                                       {
+                                           return m_stop || m_generation != old_generation;
+                                       });
+                        if (m_stop)
+                        {
+                            return;
+                        }
+                        old_generation = m_generation;
+                        task           = m_task;
+                        context        = m_context;
+                    }
+
+                    task(context);
+
+                    std::lock_guard<std::mutex> lock(m_mutex);
+                    if (--m_pending == 0)
+                    {
+                        m_done.notify_one();
+                    }
+                }
+            }
+
+            std::vector<std::thread> m_workers;
+            std::mutex m_run_mutex;
+            std::mutex m_mutex;
+            std::condition_variable m_wake_up;
+            std::condition_variable m_done;
+            void (*m_task)(void*)    = nullptr;
+            void* m_context          = nullptr;
+            std::size_t m_pending    = 0;
+            std::size_t m_generation = 0;
+            bool m_stop              = false;
+        };
+
+        /// The state of one loop shared by the threads of the pool.
+        template <class Func>
+        struct LoopTask
+        {
+            LoopTask(Func& f_, std::size_t size_, std::size_t grain_)
+                : f(f_)
+                , size(size_)
+                , grain(std::max(grain_, std::size_t{1}))
+            {
+            }
+
+            static void run(void* context)
+            {
+                auto& loop = *static_cast<LoopTask*>(context);
+                ParallelScope scope;
+                while (true)
+                {
+                    const std::size_t begin = loop.next.fetch_add(loop.grain, std::memory_order_relaxed);
+                    if (begin >= loop.size)
+                    {
+                        return;
+                    }
+                    const std::size_t end = std::min(begin + loop.grain, loop.size);
+                    try
+                    {
+                        for (std::size_t i = begin; i < end; ++i)
+                        {
+                            loop.f(i);
+                        }
+                    }
+                    catch (...)
+                    {
+                        std::lock_guard<std::mutex> lock(loop.error_mutex);
+                        if (!loop.error)
+                        {
+                            loop.error = std::current_exception();
+                        }
+                        loop.next.store(loop.size, std::memory_order_relaxed);
+                        return;
+                    }
+                }
+            }
+
+            Func& f;
+            std::size_t size;
+            std::size_t grain;
+            std::atomic<std::size_t> next{0};
+            std::mutex error_mutex;
+            std::exception_ptr error;
+        };
+
+        /// A function called once by each thread of the pool.
+        template <class Func>
+        struct ThreadTask
+        {
+            ThreadTask(Func& f_, std::size_t nb_threads_)
+                : f(f_)
+                , nb_threads(nb_threads_)
+            {
+            }
+
+            static void run(void* context)
+            {
+                auto& task = *static_cast<ThreadTask*>(context);
+                ParallelScope scope;
+                try
+                {
+                    task.f(thread_index, task.nb_threads);
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(task.error_mutex);
+                    if (!task.error)
+                    {
+                        task.error = std::current_exception();
+                    }
+                }
+            }
+
+            Func& f;
+            std::size_t nb_threads;
+            std::mutex error_mutex;
+            std::exception_ptr error;
+        };
+    }
+
+    inline std::size_t max_threads()
+    {
+        return detail::ThreadPool::instance().size();
+    }
+
+    inline std::size_t thread_num()
+    {
+        return detail::thread_index;
+    }
+
+    /// Call f(i) for i in [0, size[ on the threads of the pool, grain consecutive indices being given at once to a thread.
+    template <class Func>
+    inline void for_each_index(std::size_t size, Func&& f, std::size_t grain = 1)
+    {
+        using loop_t = detail::LoopTask<std::remove_reference_t<Func>>;
+
+        auto& pool = detail::ThreadPool::instance();
+        loop_t loop(f, size, grain);
+        // nested or concurrent loops are run by the calling thread alone
+        if (in_parallel() || pool.size() == 1 || size <= 1 || !pool.run(&loop_t::run, &loop))
+        {
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                f(i);
+            }
+            return;
+        }
+        if (loop.error)
+        {
+            std::rethrow_exception(loop.error);
+        }
+    }
+
+    /**
+     * Call f(thread, nb_threads) once on each thread of the pool. Splitting
+     * the work by thread gives a static partition: a part is always given to
+     * the same thread, which is the one which touched its memory first.
+     */
+    template <class Func>
+    inline void for_each_thread(Func&& f)
+    {
+        using task_t = detail::ThreadTask<std::remove_reference_t<Func>>;
+
+        auto& pool = detail::ThreadPool::instance();
+        task_t task(f, pool.size());
+        if (in_parallel() || pool.size() == 1 || !pool.run(&task_t::run, &task))
+        {
+            f(std::size_t{0}, std::size_t{1});
+            return;
+        }
+        if (task.error)
+        {
+            std::rethrow_exception(task.error);
+        }
+    }
+
+#endif
+
+#else
+
+    inline std::size_t max_threads()
+    {
+        return 1;
+    }
+
+    inline std::size_t thread_num()
+    {
+        return 0;
+    }
+
+    inline bool in_parallel()
+    {
+        return false;
+    }
+
+    template <class Func>
+    inline void for_each_index(std::size_t size, Func&& f, std::size_t = 1)
+    {
+        for (std::size_t i = 0; i < size; ++i)
+        {
+            f(i);
+        }
+    }
+
+    template <class Func>
+    inline void for_each_thread(Func&& f)
+    {
+        f(std::size_t{0}, std::size_t{1});
+    }
+
+#endif
+
+    /// target += value, safe when several threads update the same value.
+    template <class T, class U>
+    inline void atomic_add(T& target, const U& value)
+    {
+#if defined(SAMURAI_WITH_OPENMP)
+#pragma omp atomic update
+        target += value;
+#elif defined(SAMURAI_WITH_PARALLEL)
+        std::atomic_ref<T>(target).fetch_add(static_cast<T>(value), std::memory_order_relaxed);
+#else
+        target += value;
+#endif
+    }
+}
@@ -1,6 +1,7 @@
 #pragma once
 #include "fv/cell_based_scheme_assembly.hpp"
 #include "fv/flux_based_scheme_assembly.hpp"
+#include "../parallel.hpp"
 #include "fv/operator_sum_assembly.hpp"
 #include "utils.hpp"
 #include <petsc.h>
@@ -18,12 +19,12 @@ namespace samurai
 #define SAMURAI_VERSIONIFY(M, m, v) SAMURAI_STRINGIFY(M.m.v)
 
 
-#ifdef SAMURAI_WITH_OPENMP
+#ifdef SAMURAI_WITH_PARALLEL
     #if !PetscDefined(HAVE_THREADSAFETY)
-        #pragma message("To enable OpenMP for independent non-linear systems, PETSc must be configured with option --with-threadsafety.")
+        #pragma message("To solve the independent non-linear systems in parallel, PETSc must be configured with option --with-threadsafety.")
     #endif
     #if PETSC_VERSION_LT(3, 20, 6)
-        #pragma message("To enable OpenMP for independent non-linear systems, upgrade PETSc to version 3.20.6 or upper (current version: " SAMURAI_VERSIONIFY(PETSC_VERSION_MAJOR, PETSC_VERSION_MINOR, PETSC_VERSION_SUBMINOR) ")")
+        #pragma message("To solve the independent non-linear systems in parallel, upgrade PETSc to version 3.20.6 or upper (current version: " SAMURAI_VERSIONIFY(PETSC_VERSION_MAJOR, PETSC_VERSION_MINOR, PETSC_VERSION_SUBMINOR) ")")
     #endif
     #if PetscDefined(HAVE_THREADSAFETY) && PETSC_VERSION_GE(3, 20, 6)
         #define ENABLE_PARALLEL_NONLINEAR_SOLVES
@@ -124,7 +125,7 @@ namespace samurai
 
 #ifdef ENABLE_PARALLEL_NONLINEAR_SOLVES
                 static constexpr Run run_type = Run::Parallel;
-                std::size_t n_threads         = static_cast<std::size_t>(omp_get_max_threads());
+                std::size_t n_threads         = parallel::max_threads();
 #else
                 static constexpr Run run_type = Run::Sequential;
                 std::size_t n_threads         = 1;
@@ -133,19 +134,19 @@ namespace samurai
                 std::vector<Mat> J_list(n_threads);
                 std::vector<Vec> r_list(n_threads);
 
-#pragma omp parallel for
-                for (std::size_t thread_num = 0; thread_num < n_threads; ++thread_num)
-                {
-                    SNESCreate(PETSC_COMM_SELF, &snes_list[thread_num]);
-                    MatCreateSeqDense(PETSC_COMM_SELF, n, n, NULL, &J_list[thread_num]);
-                    VecCreateSeq(PETSC_COMM_SELF, n, &r_list[thread_num]);
-                }
+                parallel::for_each_index(n_threads,
+                                         [&](std::size_t thread_num)
+                                         {
+                                             SNESCreate(PETSC_COMM_SELF, &snes_list[thread_num]);
+                                             MatCreateSeqDense(PETSC_COMM_SELF, n, n, NULL, &J_list[thread_num]);
+                                             VecCreateSeq(PETSC_COMM_SELF, n, &r_list[thread_num]);
+                                         });
 
                 for_each_cell<run_type>(unknown().mesh(),
                                         [&](auto& cell)
                                         {
 #ifdef ENABLE_PARALLEL_NONLINEAR_SOLVES
-                                            std::size_t thread_num = static_cast<std::size_t>(omp_get_thread_num());
+                                            std::size_t thread_num = parallel::thread_num();
 #else
                                             std::size_t thread_num = 0;
 #endif
@@ -185,13 +186,13 @@ namespace samurai
                                             VecDestroy(&b);
                                         });
 
-#pragma omp parallel for
-                for (std::size_t thread_num = 0; thread_num < n_threads; ++thread_num)
-                {
-                    MatDestroy(&J_list[thread_num]);
-                    VecDestroy(&r_list[thread_num]);
-                    SNESDestroy(&snes_list[thread_num]);
-                }
+                parallel::for_each_index(n_threads,
+                                         [&](std::size_t thread_num)
+                                         {
+                                             MatDestroy(&J_list[thread_num]);
+                                             VecDestroy(&r_list[thread_num]);
+                                             SNESDestroy(&snes_list[thread_num]);
+                                         });
             }
 
           private:
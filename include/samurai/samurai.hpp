@@ -9,6 +9,7 @@ namespace mpi = boost::mpi;
 #endif
 
 #include "arguments.hpp"
+#include "storage/memory_pool.hpp"
 #include "timers.hpp"
 
 namespace samurai
@@ -29,6 +30,7 @@ namespace samurai
     {
         app.description(description);
         read_samurai_arguments(app, argc, argv);
+        MemoryPool::instance().max_cached_arrays(args::field_pool_size);
 
 #ifdef SAMURAI_WITH_MPI
         MPI_Init(&argc, &argv);
@@ -63,6 +65,10 @@ namespace samurai
             times::timers.stop("total runtime");
             std::cout << std::endl;
             times::timers.print();
+
+            const auto pool = MemoryPool::instance().statistics();
+            std::cout << "field memory pool: " << pool.hits << " hits, " << pool.misses << " misses, "
+                      << pool.cached_bytes / (1024 * 1024) << " MiB cached" << std::endl;
         }
 #ifdef SAMURAI_WITH_MPI
         MPI_Finalize();
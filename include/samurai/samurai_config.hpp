@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <cstdint>
+
 namespace samurai
 {
     static constexpr bool disable_color = true;
@@ -17,8 +19,18 @@ namespace samurai
         static constexpr std::size_t graduation_width = 1;
         static constexpr std::size_t prediction_order = 1;
 
-        using index_t    = signed long long int;
-        using value_t    = int;
-        using interval_t = Interval<value_t, index_t>;
+        using value_t = int;
+
+        /// Storage index type of the intervals. With SAMURAI_COMPACT_INTERVAL,
+        /// a 32-bit index is used so that an interval takes 16 bytes instead of 24
+        /// (valid for meshes with less than 2^31 cells).
+        using compact_index_t = std::int32_t;
+#ifdef SAMURAI_COMPACT_INTERVAL
+        using index_t = compact_index_t;
+#else
+        using index_t = signed long long int;
+#endif
+        using interval_t         = Interval<value_t, index_t>;
+        using compact_interval_t = Interval<value_t, compact_index_t>;
     }
 }
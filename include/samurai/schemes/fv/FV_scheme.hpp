@@ -31,7 +31,7 @@ namespace samurai
     {
         static constexpr std::size_t n_comp = Field::n_comp;
         using field_value_type              = typename Field::value_type;
-        using coeffs_t                      = CollapsMatrix<field_value_type, output_n_comp, n_comp, Field::is_scalar>;
+        using coeffs_t                      = CollapsMatrix<accumulation_t<field_value_type>, output_n_comp, n_comp, Field::is_scalar>;
 
         using stencil_coeffs_t = std::array<coeffs_t, bdry_stencil_size>;
         using rhs_coeffs_t     = coeffs_t;
@@ -99,6 +99,8 @@ namespace samurai
         using mesh_t           = typename field_t::mesh_t;
         using mesh_id_t        = typename mesh_t::mesh_id_t;
         using field_value_type = typename field_t::value_type; // double
+        // type of the coefficients and of the fluxes: double for the float fields
+        using accumulation_type = accumulation_t<field_value_type>;
         using size_type        = typename field_t::size_type;
 
         using cfg                                             = cfg_;
@@ -207,10 +209,10 @@ namespace samurai
         /**
          * Helper functions to get coefficients from a set of matrices
          */
-        inline field_value_type cell_coeff(const StencilJacobian<cfg>& coeffs,
-                                           std::size_t cell_number_in_stencil,
-                                           [[maybe_unused]] size_type field_i,
-                                           [[maybe_unused]] size_type field_j) const
+        inline accumulation_type cell_coeff(const StencilJacobian<cfg>& coeffs,
+                                            std::size_t cell_number_in_stencil,
+                                            [[maybe_unused]] size_type field_i,
+                                            [[maybe_unused]] size_type field_j) const
         {
             if constexpr (field_t::is_scalar && output_n_comp == 1)
             {
@@ -222,10 +224,10 @@ namespace samurai
             }
         }
 
-        inline field_value_type bdry_cell_coeff(const bdry_stencil_coeffs_t& coeffs,
-                                                std::size_t cell_number_in_stencil,
-                                                [[maybe_unused]] size_type field_i,
-                                                [[maybe_unused]] size_type field_j) const
+        inline accumulation_type bdry_cell_coeff(const bdry_stencil_coeffs_t& coeffs,
+                                                 std::size_t cell_number_in_stencil,
+                                                 [[maybe_unused]] size_type field_i,
+                                                 [[maybe_unused]] size_type field_j) const
         {
             if constexpr (field_t::is_scalar && output_n_comp == 1)
             {
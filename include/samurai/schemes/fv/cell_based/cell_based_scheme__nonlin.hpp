@@ -20,7 +20,8 @@ namespace samurai
         using bdry_cfg_t       = bdry_cfg;
         using input_field_t    = typename base_class::input_field_t;
         using mesh_t           = typename base_class::mesh_t;
-        using field_value_type = typename base_class::field_value_type;
+        using field_value_type  = typename base_class::field_value_type;
+        using accumulation_type = typename base_class::accumulation_type;
 
         using scheme_definition_t = CellBasedSchemeDefinition<cfg>;
         using scheme_stencil_t    = typename scheme_definition_t::scheme_stencil_t;
@@ -132,7 +133,7 @@ namespace samurai
             return m_scheme_definition.jacobian_function(stencil_cells, field);
         }
 
-        inline field_value_type contrib_cmpnent(const SchemeValue<cfg>& coeffs, [[maybe_unused]] size_type field_i) const
+        inline accumulation_type contrib_cmpnent(const SchemeValue<cfg>& coeffs, [[maybe_unused]] size_type field_i) const
         {
             if constexpr (input_field_t::is_scalar && cfg::output_n_comp == 1)
             {
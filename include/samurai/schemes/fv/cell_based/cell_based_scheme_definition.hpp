@@ -77,7 +77,7 @@ namespace samurai
     };
 
     template <class cfg>
-    using SchemeValue = CollapsArray<typename cfg::input_field_t::value_type,
+    using SchemeValue = CollapsArray<accumulation_t<typename cfg::input_field_t::value_type>,
                                      cfg::output_n_comp,
                                      detail::is_soa_v<typename cfg::input_field_t>,
                                      cfg::input_field_t::is_scalar>;
@@ -1,5 +1,6 @@
 #pragma once
 // #include "../../../petsc/fv/flux_based_scheme_assembly.hpp"
+#include "../../../parallel.hpp"
 #include "../explicit_FV_scheme.hpp"
 #include "flux_based_scheme__lin_hom.hpp"
 
@@ -138,8 +139,9 @@ namespace samurai
 
             using index_t = decltype(left_cell_index_init);
 
-            std::vector<value_t> left_contributions(n_left_cells, 0);
-            std::vector<value_t> right_contributions(n_right_cells, 0);
+            // the contributions are accumulated in double for the float fields
+            std::vector<accumulation_t<value_t>> left_contributions(n_left_cells, 0);
+            std::vector<accumulation_t<value_t>> right_contributions(n_right_cells, 0);
 
             for (std::size_t field_i = 0; field_i < output_n_comp; ++field_i)
             {
@@ -213,18 +215,16 @@ namespace samurai
                 // Here, the non-SIMD loops of atomic instructions are more efficient than opening a critical section and
                 // execute SIMD loops.
 
-                // clang-format off
                 for (index_t ii = 0; ii < static_cast<index_t>(left_contributions.size()); ++ii)
                 {
-                    #pragma omp atomic update
-                    field_value(output_field, left_cell_index_init + ii, field_i) += left_contributions[static_cast<std::size_t>(ii)];
+                    parallel::atomic_add(field_value(output_field, left_cell_index_init + ii, field_i),
+                                         static_cast<value_t>(left_contributions[static_cast<std::size_t>(ii)]));
                 }
                 for (index_t ii = 0; ii < static_cast<index_t>(right_contributions.size()); ++ii)
                 {
-                    #pragma omp atomic update
-                    field_value(output_field, right_cell_index_init + ii, field_i) += right_contributions[static_cast<std::size_t>(ii)];
+                    parallel::atomic_add(field_value(output_field, right_cell_index_init + ii, field_i),
+                                         static_cast<value_t>(right_contributions[static_cast<std::size_t>(ii)]));
                 }
-                // clang-format on
             }
         }
 
@@ -249,8 +249,8 @@ namespace samurai
                 input_field,
                 [&](auto& interface, auto& stencil, auto& left_cell_coeffs, auto& right_cell_coeffs)
                 {
-#ifdef SAMURAI_WITH_OPENMP
-                    if (omp_get_max_threads() > 1)
+#ifdef SAMURAI_WITH_PARALLEL
+                    if (parallel::max_threads() > 1)
                     {
                         _apply_contribution_in_parallel_context(output_field, input_field, interface, stencil, left_cell_coeffs, right_cell_coeffs);
                     }
@@ -1,4 +1,5 @@
 #pragma once
+#include "../../../parallel.hpp"
 #include "../explicit_FV_scheme.hpp"
 #include "flux_based_scheme__nonlin.hpp"
 
@@ -43,10 +44,7 @@ namespace samurai
                 {
                     for (size_type field_i = 0; field_i < output_n_comp; ++field_i)
                     {
-                    // clang-format off
-                        #pragma omp atomic update
-                        field_value(output_field, cell, field_i) += this->scheme().flux_value_cmpnent(contrib, field_i);
-                        // clang-format on
+                        parallel::atomic_add(field_value(output_field, cell, field_i), this->scheme().flux_value_cmpnent(contrib, field_i));
                     }
                 });
 
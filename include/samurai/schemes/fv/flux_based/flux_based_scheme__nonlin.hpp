@@ -20,6 +20,7 @@ namespace samurai
         using base_class::output_n_comp;
         using size_type = typename base_class::size_type;
 
+        using typename base_class::accumulation_type;
         using typename base_class::field_value_type;
         using typename base_class::input_field_t;
         using typename base_class::mesh_id_t;
@@ -100,7 +101,7 @@ namespace samurai
 
       public:
 
-        inline field_value_type flux_value_cmpnent(const FluxValue<cfg>& flux_value, [[maybe_unused]] size_type field_i) const
+        inline accumulation_type flux_value_cmpnent(const FluxValue<cfg>& flux_value, [[maybe_unused]] size_type field_i) const
         {
             if constexpr (output_field_t::is_scalar)
             {
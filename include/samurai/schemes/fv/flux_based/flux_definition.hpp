@@ -63,7 +63,7 @@ namespace samurai
     //----------------------------------//
 
     template <class cfg>
-    using FluxValue = CollapsFluxArray<typename cfg::input_field_t::value_type, cfg::output_n_comp, cfg::input_field_t::is_scalar>;
+    using FluxValue = CollapsFluxArray<accumulation_t<typename cfg::input_field_t::value_type>, cfg::output_n_comp, cfg::input_field_t::is_scalar>;
 
     template <class cfg>
     using FluxValuePair = StdArrayWrapper<FluxValue<cfg>, 2>;
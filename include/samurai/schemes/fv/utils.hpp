@@ -18,7 +18,10 @@ namespace samurai
     using StencilValues = CollapsStdArray<typename cfg::input_field_t::local_data_type, cfg::stencil_size, cfg::input_field_t::is_scalar>;
 
     template <class cfg>
-    using JacobianMatrix = CollapsMatrix<typename cfg::input_field_t::value_type, cfg::output_n_comp, cfg::input_field_t::n_comp, cfg::input_field_t::is_scalar>;
+    using JacobianMatrix = CollapsMatrix<accumulation_t<typename cfg::input_field_t::value_type>,
+                                         cfg::output_n_comp,
+                                         cfg::input_field_t::n_comp,
+                                         cfg::input_field_t::is_scalar>;
 
     template <class cfg>
     using StencilJacobian = StdArrayWrapper<JacobianMatrix<cfg>, cfg::stencil_size>;
@@ -0,0 +1,119 @@
+// Copyright 2018-2025 the samurai's authors
+// SPDX-License-Identifier:  BSD-3-Clause
+
+#pragma once
+
+#include <cstddef>
+#include <limits>
+#include <new>
+
+#include "memory_pool.hpp"
+
+#if defined(SAMURAI_FIELD_HUGE_PAGES) && defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace samurai
+{
+    /// Alignment of the field arrays: a cache line, which is also the size of the widest SIMD registers.
+    static constexpr std::size_t field_alignment = 64;
+
+    /// Size of the transparent huge pages used by the large field arrays with SAMURAI_FIELD_HUGE_PAGES.
+    static constexpr std::size_t huge_page_size = 2 * 1024 * 1024;
+
+    /** @class aligned_allocator
+     *  @brief Allocator of the field arrays.
+     *
+     * The arrays are aligned on Alignment bytes. With SAMURAI_FIELD_HUGE_PAGES
+     * on Linux, the arrays larger than a huge page are aligned on huge pages
+     * and the kernel is advised to back them with transparent huge pages.
+     *
+     * The memory is not initialized: its pages are placed on the NUMA node of
+     * the thread which touches them first.
+     */
+    template <class T, std::size_t Alignment = field_alignment>
+    class aligned_allocator
+    {
+      public:
+
+        static_assert(Alignment >= alignof(T), "the alignment must be at least the one of the type");
+
+        using value_type      = T;
+        using size_type       = std::size_t;
+        using difference_type = std::ptrdiff_t;
+
+        static constexpr std::size_t alignment = Alignment;
+
+        template <class U>
+        struct rebind
+        {
+            using other = aligned_allocator<U, Alignment>;
+        };
+
+        aligned_allocator() noexcept
+        {
+            // the pool is created before the containers, hence destroyed after them
+            MemoryPool::instance();
+        }
+
+        template <class U>
+        aligned_allocator(const aligned_allocator<U, Alignment>&) noexcept // NOLINT(google-explicit-constructor)
+        {
+            MemoryPool::instance();
+        }
+
+        T* allocate(std::size_t n)
+        {
+            if (n > std::numeric_limits<std::size_t>::max() / sizeof(T))
+            {
+                throw std::bad_array_new_length();
+            }
+            const std::size_t bytes     = n * sizeof(T);
+            const std::size_t alignment = memory_alignment(bytes);
+            if (void* p = MemoryPool::instance().acquire(bytes, alignment))
+            {
+                return static_cast<T*>(p);
+            }
+            // the whole size class is allocated so that the array can be reused by the pool
+            const std::size_t size = MemoryPool::block_size(bytes);
+            void* p                = ::operator new(size, std::align_val_t{alignment});
+#if defined(SAMURAI_FIELD_HUGE_PAGES) && defined(__linux__) && defined(MADV_HUGEPAGE)
+            if (size >= huge_page_size)
+            {
+                // only a hint: the allocation is valid if it is ignored
+                madvise(p, size, MADV_HUGEPAGE);
+            }
+#endif
+            MemoryPool::instance().allocated(p, bytes);
+            return static_cast<T*>(p);
+        }
+
+        void deallocate(T* p, std::size_t n) noexcept
+        {
+            const std::size_t bytes     = n * sizeof(T);
+            const std::size_t alignment = memory_alignment(bytes);
+            if (!MemoryPool::instance().give_back(p, bytes, alignment))
+            {
+                ::operator delete(p, std::align_val_t{alignment});
+            }
+        }
+
+        friend bool operator==(const aligned_allocator&, const aligned_allocator&) noexcept
+        {
+            return true;
+        }
+
+      private:
+
+        static constexpr std::size_t memory_alignment([[maybe_unused]] std::size_t bytes)
+        {
+#ifdef SAMURAI_FIELD_HUGE_PAGES
+            if (bytes >= huge_page_size)
+            {
+                return huge_page_size;
+            }
+#endif
+            return Alignment;
+        }
+    };
+}
@@ -3,6 +3,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include <Eigen/Core>
 
 #include "../utils.hpp"
@@ -91,6 +93,42 @@ namespace samurai
             }
         }
 
+        /// Call f(begin, end) for the ranges [begin, end[ of data() which hold the items [first, last[ of all the components.
+        template <class Func>
+        void for_each_range(size_type first, size_type last, Func&& f) const
+        {
+            // the items of a component are contiguous in both layouts
+            const size_type nb_items = m_data.size() / static_cast<size_type>(size);
+            for (size_type c = 0; c < static_cast<size_type>(size); ++c)
+            {
+                f(c * nb_items + first, c * nb_items + last);
+            }
+        }
+
+        /// Set the values of the items [first, last[ to value, for all the components.
+        void fill(size_type first, size_type last, value_t value)
+        {
+            for_each_range(first,
+                           last,
+                           [&](size_type begin, size_type end)
+                           {
+                               std::fill(m_data.data() + begin, m_data.data() + end, value);
+                           });
+        }
+
+        /// Copy the items [other_first, other_first + last - first[ of other to the items [first, last[, for all the components.
+        void copy(size_type first, size_type last, const eigen_container& other, size_type other_first)
+        {
+            const size_type nb_items       = m_data.size() / static_cast<size_type>(size);
+            const size_type other_nb_items = other.m_data.size() / static_cast<size_type>(size);
+            for (size_type c = 0; c < static_cast<size_type>(size); ++c)
+            {
+                std::copy(other.m_data.data() + c * other_nb_items + other_first,
+                          other.m_data.data() + c * other_nb_items + other_first + last - first,
+                          m_data.data() + c * nb_items + first);
+            }
+        }
+
       private:
 
         container_t m_data;
@@ -216,6 +254,21 @@ namespace samurai
         return exp.derived().eval();
     }
 
+    /// The expression with its values converted to their accumulation type.
+    template <class E>
+    auto accumulation_cast(E&& exp)
+    {
+        using value_t = typename std::decay_t<E>::Scalar;
+        if constexpr (std::is_same_v<accumulation_t<value_t>, value_t>)
+        {
+            return std::forward<E>(exp);
+        }
+        else
+        {
+            return exp.template cast<accumulation_t<value_t>>();
+        }
+    }
+
     template <class D>
     auto shape(const Eigen::EigenBase<D>& exp, std::size_t axis)
     {
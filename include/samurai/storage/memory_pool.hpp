@@ -0,0 +1,361 @@
+// Copyright 2018-2025 the samurai's authors
+// SPDX-License-Identifier:  BSD-3-Clause
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <compare>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <new>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../parallel.hpp"
+
+namespace samurai
+{
+    /** @class MemoryPool
+     *  @brief Cache of the arrays of the fields.
+     *
+     * The array of a field which is destroyed or resized is kept in the pool
+     * and given to the next field which needs an array of about the same
+     * size, instead of being given back to the system. The temporary fields
+     * of the schemes, of the time steps and of the mesh adaptation thus reuse
+     * the same arrays and their pages are not faulted in again.
+     *
+     * The sizes are rounded up to size classes, four per power of two, so
+     * that an array is reused for the sizes at most 25% smaller. The arrays
+     * smaller than a page are not worth it and are not cached. The pool is
+     * global and thread-safe. The cache holds at most max_cached_arrays()
+     * arrays of the size of the largest array it has seen: the oldest arrays
+     * of the cache are freed to make room for the new ones. The cache is per
+     * process, hence per MPI rank.
+     *
+     * A cached array keeps the pages placed by its previous use. With several
+     * threads, the arrays are allocated in a Placement scope whose key
+     * identifies how their pages are placed (see detail::first_touch): an
+     * array is only reused in a scope with the same key and for the same
+     * number of bytes, so that its pages are already on the NUMA nodes of the
+     * threads which traverse the new field.
+     */
+    class MemoryPool
+    {
+      public:
+
+        struct Statistics
+        {
+            /// Number of arrays given by the cache.
+            std::size_t hits = 0;
+            /// Number of arrays allocated since the cache had none of their size and placement.
+            std::size_t misses = 0;
+            /// Number of arrays in the cache.
+            std::size_t cached_blocks = 0;
+            /// Size in bytes of the arrays in the cache.
+            std::size_t cached_bytes = 0;
+        };
+
+        /** @class Placement
+         *  @brief Placement of the arrays allocated by the current thread in its scope.
+         *
+         * The key is ignored, hence all the arrays are interchangeable, when
+         * the pages are not placed by first touch.
+         */
+        class Placement
+        {
+          public:
+
+            explicit Placement(std::size_t key)
+                : m_previous(current())
+            {
+                current() = {placed_by_first_touch() ? key : 0, false};
+            }
+
+            Placement(const Placement&)            = delete;
+            Placement& operator=(const Placement&) = delete;
+
+            ~Placement()
+            {
+                current() = m_previous;
+            }
+
+            /// Whether an array was given by the cache in this scope: its pages are already placed.
+            bool reused() const
+            {
+                return current().reused;
+            }
+
+          private:
+
+            friend class MemoryPool;
+
+            struct State
+            {
+                std::size_t key = 0;
+                bool reused     = false;
+            };
+
+            static State& current()
+            {
+                thread_local State state;
+                return state;
+            }
+
+            State m_previous;
+        };
+
+        static MemoryPool& instance()
+        {
+            static MemoryPool pool;
+            return pool;
+        }
+
+        MemoryPool(const MemoryPool&)            = delete;
+        MemoryPool& operator=(const MemoryPool&) = delete;
+
+        ~MemoryPool()
+        {
+            release();
+        }
+
+        /// Whether the NUMA placement of the field arrays relies on the first touch of several threads.
+        static bool placed_by_first_touch()
+        {
+            return parallel::max_threads() > 1;
+        }
+
+        static constexpr bool is_pooled(std::size_t bytes)
+        {
+            return bytes >= min_step;
+        }
+
+        /// Size of the arrays allocated for bytes bytes.
+        static constexpr std::size_t block_size(std::size_t bytes)
+        {
+            if (!is_pooled(bytes))
+            {
+                return bytes;
+            }
+            // 2^k < bytes <= 2^(k+1): the classes are 2^k + j 2^(k-2) for j = 1, ..., 4
+            const std::size_t step = std::max(min_step, std::size_t{1} << (std::bit_width(bytes - 1) - 3));
+            return (bytes + step - 1) / step * step;
+        }
+
+        /**
+         * Take from the cache an array of block_size(bytes) bytes aligned on
+         * alignment bytes, with the placement of the current Placement scope.
+         *
+         * @return nullptr if the cache has none: the caller allocates it and
+         * records it with allocated.
+         */
+        void* acquire(std::size_t bytes, std::size_t alignment)
+        {
+            if (!is_pooled(bytes))
+            {
+                return nullptr;
+            }
+            const block_key key = key_of(bytes, alignment);
+            std::lock_guard<std::mutex> lock(m_mutex);
+            auto it = m_blocks.find(key);
+            if (it == m_blocks.end() || it->second.empty())
+            {
+                ++m_statistics.misses;
+                return nullptr;
+            }
+            void* p = it->second.back().first;
+            if (key.placement != 0)
+            {
+                m_placements[p]             = key.placement;
+                Placement::current().reused = true;
+            }
+            it->second.pop_back();
+            ++m_statistics.hits;
+            --m_statistics.cached_blocks;
+            m_statistics.cached_bytes -= key.size;
+            return p;
+        }
+
+        /// Record the placement of an array allocated by the caller for bytes bytes after a miss of acquire.
+        void allocated(void* p, std::size_t bytes) noexcept
+        {
+            if (!is_pooled(bytes))
+            {
+                return;
+            }
+            const std::size_t placement = Placement::current().key;
+            if (placement != 0)
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                try
+                {
+                    m_placements[p] = placement;
+                }
+                catch (...)
+                {
+                    // the placement of the array is then unknown
+                }
+            }
+        }
+
+        /**
+         * Give back to the cache an array given by acquire or allocated by
+         * the caller for bytes bytes.
+         *
+         * @return false if the cache is full: the caller frees the array.
+         */
+        bool give_back(void* p, std::size_t bytes, std::size_t alignment) noexcept
+        {
+            if (!is_pooled(bytes))
+            {
+                return false;
+            }
+            block_key key{block_size(bytes), alignment, 0, 0};
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (auto it = m_placements.find(p); it != m_placements.end())
+            {
+                // the pages of the array are placed for the layout of its field
+                key.placement = it->second;
+                key.bytes     = bytes;
+                m_placements.erase(it);
+            }
+            m_largest_block = std::max(m_largest_block, key.size);
+            if (key.size > max_cached_bytes_unlocked())
+            {
+                return false;
+            }
+            while (m_statistics.cached_bytes + key.size > max_cached_bytes_unlocked())
+            {
+                free_oldest();
+            }
+            try
+            {
+                m_blocks[key].emplace_back(p, ++m_clock);
+            }
+            catch (...)
+            {
+                return false;
+            }
+            ++m_statistics.cached_blocks;
+            m_statistics.cached_bytes += key.size;
+            return true;
+        }
+
+        /// Free the arrays of the cache and forget the size of the largest one.
+        void release() noexcept
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            for (auto& [key, blocks] : m_blocks)
+            {
+                for (auto& block : blocks)
+                {
+                    ::operator delete(block.first, std::align_val_t{key.alignment});
+                }
+            }
+            m_blocks.clear();
+            m_largest_block            = 0;
+            m_statistics.cached_blocks = 0;
+            m_statistics.cached_bytes  = 0;
+        }
+
+        /// Maximal number of arrays of the largest size in the cache.
+        std::size_t max_cached_arrays() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_max_cached_arrays;
+        }
+
+        /// Set the maximal number of arrays of the largest size in the cache; 0 disables it.
+        void max_cached_arrays(std::size_t n)
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_max_cached_arrays = n;
+                if (m_statistics.cached_bytes <= max_cached_bytes_unlocked())
+                {
+                    return;
+                }
+            }
+            release();
+        }
+
+        /// Maximal size in bytes of the cache: max_cached_arrays() times the size of the largest array given back.
+        std::size_t max_cached_bytes() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return max_cached_bytes_unlocked();
+        }
+
+        Statistics statistics() const
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            return m_statistics;
+        }
+
+        void reset_statistics()
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_statistics.hits   = 0;
+            m_statistics.misses = 0;
+        }
+
+      private:
+
+        static constexpr std::size_t min_step                  = 4096;
+        static constexpr std::size_t default_max_cached_arrays = 8;
+
+        MemoryPool() = default;
+
+        struct block_key
+        {
+            std::size_t size;
+            std::size_t alignment;
+            // 0 if the placement of the pages is not known
+            std::size_t placement;
+            // the size requested for the array if its placement is known
+            std::size_t bytes;
+
+            friend auto operator<=>(const block_key&, const block_key&) = default;
+        };
+
+        static block_key key_of(std::size_t bytes, std::size_t alignment)
+        {
+            const std::size_t placement = Placement::current().key;
+            return {block_size(bytes), alignment, placement, placement == 0 ? 0 : bytes};
+        }
+
+        std::size_t max_cached_bytes_unlocked() const
+        {
+            return m_max_cached_arrays * m_largest_block;
+        }
+
+        /// Free the array which is in the cache for the longest time.
+        void free_oldest() noexcept
+        {
+            auto oldest = m_blocks.end();
+            for (auto it = m_blocks.begin(); it != m_blocks.end(); ++it)
+            {
+                if (!it->second.empty() && (oldest == m_blocks.end() || it->second.front().second < oldest->second.front().second))
+                {
+                    oldest = it;
+                }
+            }
+            ::operator delete(oldest->second.front().first, std::align_val_t{oldest->first.alignment});
+            oldest->second.erase(oldest->second.begin());
+            --m_statistics.cached_blocks;
+            m_statistics.cached_bytes -= oldest->first.size;
+        }
+
+        mutable std::mutex m_mutex;
+        // arrays of the cache, from the oldest to the newest, with the time they were given back
+        std::map<block_key, std::vector<std::pair<void*, std::size_t>>> m_blocks;
+        // placement of the arrays in use allocated in a Placement scope
+        std::unordered_map<void*, std::size_t> m_placements;
+        std::size_t m_max_cached_arrays = default_max_cached_arrays;
+        std::size_t m_largest_block     = 0;
+        std::size_t m_clock             = 0;
+        Statistics m_statistics;
+    };
+}
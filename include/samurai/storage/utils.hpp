@@ -35,6 +35,26 @@ namespace samurai
         static constexpr bool static_size_first_v = static_size_first<size, SOA, can_collapse, L>::value;
     }
 
+    /**
+     * Type in which the values of type T are accumulated by the schemes and
+     * the multiresolution operators: the fields stored in float are computed
+     * in double, the values being converted when they are loaded and stored.
+     */
+    template <class T>
+    struct accumulation_type
+    {
+        using type = T;
+    };
+
+    template <>
+    struct accumulation_type<float>
+    {
+        using type = double;
+    };
+
+    template <class T>
+    using accumulation_t = typename accumulation_type<T>::type;
+
     template <class T>
     struct range_t
     {
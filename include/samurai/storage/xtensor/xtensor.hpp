@@ -3,11 +3,16 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+
 // #include <xtensor/xlayout.hpp>
 #include <xtensor/xnoalias.hpp>
+#include <xtensor/xoperation.hpp>
 #include <xtensor/xtensor.hpp>
 #include <xtensor/xview.hpp>
 
+#include "../aligned_allocator.hpp"
 #include "../utils.hpp"
 
 namespace samurai
@@ -43,7 +48,8 @@ namespace samurai
     struct xtensor_container
     {
         static constexpr layout_type static_layout = SAMURAI_DEFAULT_LAYOUT;
-        using container_t = xt::xtensor<value_t, ((size == 1) && can_collapse) ? 1 : 2, detail::xtensor_layout_v<static_layout>>;
+        using container_t = xt::
+            xtensor<value_t, ((size == 1) && can_collapse) ? 1 : 2, detail::xtensor_layout_v<static_layout>, aligned_allocator<value_t>>;
         using size_type   = std::size_t;
 
         xtensor_container() = default;
@@ -83,6 +89,71 @@ namespace samurai
             }
         }
 
+        /// Call f(begin, end) for the ranges [begin, end[ of data() which hold the items [first, last[ of all the components.
+        template <class Func>
+        void for_each_range(std::size_t first, std::size_t last, Func&& f) const
+        {
+            if constexpr ((size == 1) && can_collapse)
+            {
+                f(first, last);
+            }
+            else
+            {
+                // the items of a component are contiguous if they are along the last axis
+                // in row-major, or along the first one in column-major
+                constexpr bool static_first = detail::static_size_first_v<size, SOA, can_collapse, static_layout>;
+                if constexpr (static_first == (static_layout == layout_type::row_major))
+                {
+                    const std::size_t nb_items = m_data.size() / size;
+                    for (std::size_t c = 0; c < size; ++c)
+                    {
+                        f(c * nb_items + first, c * nb_items + last);
+                    }
+                }
+                else
+                {
+                    f(first * size, last * size);
+                }
+            }
+        }
+
+        /// Set the values of the items [first, last[ to value, for all the components.
+        void fill(std::size_t first, std::size_t last, value_t value)
+        {
+            value_t* data = m_data.data();
+            for_each_range(first,
+                           last,
+                           [&](std::size_t begin, std::size_t end)
+                           {
+                               std::fill(data + begin, data + end, value);
+                           });
+        }
+
+        /// Copy the items [other_first, other_first + last - first[ of other to the items [first, last[, for all the components.
+        void copy(std::size_t first, std::size_t last, const xtensor_container& other, std::size_t other_first)
+        {
+            // the ranges of both containers are given component by component
+            std::array<std::size_t, size> other_begins;
+            std::size_t c = 0;
+            other.for_each_range(other_first,
+                                 other_first + last - first,
+                                 [&](std::size_t begin, std::size_t)
+                                 {
+                                     other_begins[c++] = begin;
+                                 });
+
+            const value_t* other_data = other.m_data.data();
+            value_t* data             = m_data.data();
+            c                         = 0;
+            for_each_range(first,
+                           last,
+                           [&](std::size_t begin, std::size_t end)
+                           {
+                               std::copy(other_data + other_begins[c], other_data + other_begins[c] + (end - begin), data + begin);
+                               ++c;
+                           });
+        }
+
       private:
 
         container_t m_data;
@@ -231,6 +302,21 @@ namespace samurai
         return xt::eval(exp.derived_cast());
     }
 
+    /// The expression with its values converted to their accumulation type.
+    template <class E>
+    auto accumulation_cast(E&& exp)
+    {
+        using value_t = typename std::decay_t<E>::value_type;
+        if constexpr (std::is_same_v<accumulation_t<value_t>, value_t>)
+        {
+            return std::forward<E>(exp);
+        }
+        else
+        {
+            return xt::cast<accumulation_t<value_t>>(std::forward<E>(exp));
+        }
+    }
+
     template <class D1, class D2>
     bool compare(const xt::xexpression<D1>& exp1, const xt::xexpression<D2>& exp2)
     {
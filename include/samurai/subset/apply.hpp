@@ -3,13 +3,51 @@
 
 #pragma once
 
+#include <algorithm>
+#include <limits>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "../algorithm.hpp"
+#include "../parallel.hpp"
 #include "concepts.hpp"
 #include "utils.hpp"
+#include "visitor.hpp"
 
 namespace samurai
 {
     namespace detail
     {
+        /// False if the set is known to be empty without traversing it.
+        template <class Set>
+        bool may_exist(const Set& set)
+        {
+            return set.exist() && !set.bounding_box().empty();
+        }
+
+        /**
+         * Function of apply_impl called once per row, with the intervals of
+         * the row gathered in row (see apply_rows).
+         */
+        template <class Func, class interval_t>
+        struct row_function
+        {
+            Func& func;
+            std::vector<interval_t> row;
+        };
+
+        template <class Func>
+        struct is_row_function : std::false_type
+        {
+        };
+
+        template <class Func, class interval_t>
+        struct is_row_function<row_function<Func, interval_t>> : std::true_type
+        {
+        };
+
         template <std::size_t dim, class Set, class Func, class Container>
         bool apply_impl(Set&& global_set, Func&& func, Container& index)
         {
@@ -32,6 +70,24 @@ namespace samurai
                 };
                 return apply(set, start_and_stop, func_int);
             }
+            else if constexpr (is_row_function<std::decay_t<Func>>::value)
+            {
+                // the position along the other dimensions is fixed: the intervals of the row are given at once
+                auto& row = func.row;
+                row.clear();
+                apply(set,
+                      start_and_stop,
+                      [&row](const auto& interval)
+                      {
+                          row.push_back(interval);
+                          return false;
+                      });
+                if (!row.empty())
+                {
+                    func.func(std::span<const typename std::decay_t<decltype(row)>::value_type>(row), std::as_const(index));
+                }
+                return false;
+            }
             else
             {
                 auto func_int = [&](const auto& interval)
@@ -55,7 +111,28 @@ namespace samurai
             return false;
         };
 
-        if (global_set.exist())
+        if (detail::may_exist(global_set))
+        {
+            detail::apply_impl<dim>(std::forward<Set>(global_set), func, index);
+        }
+    }
+
+    /**
+     * Same traversal as apply, but the intervals are given row by row:
+     * func(row, yz) is called once per non-empty position yz along the other
+     * dimensions, where row is a span over the sorted intervals of this
+     * position. The span is only valid during the call.
+     */
+    template <class Set, class Func>
+    void apply_rows(Set&& global_set, Func&& row_func)
+    {
+        constexpr std::size_t dim = std::decay_t<Set>::dim;
+        using interval_t          = typename std::decay_t<Set>::interval_t;
+        xt::xtensor_fixed<int, xt::xshape<dim - 1>> index;
+
+        detail::row_function<Func, interval_t> func{row_func, {}};
+
+        if (detail::may_exist(global_set))
         {
             detail::apply_impl<dim>(std::forward<Set>(global_set), func, index);
         }
@@ -72,13 +149,263 @@ namespace samurai
             return true;
         };
 
-        if (global_set.exist())
+        if (detail::may_exist(global_set))
         {
             return !detail::apply_impl<dim>(std::forward<Set>(global_set), func, index);
         }
         return true;
     }
 
+    /**
+     * Number of cells of the set, computed without a user function.
+     *
+     * The traversal stops once max_count cells are found: count_cells(set, n) >= n
+     * tells if the set has at least n cells without reading it entirely.
+     */
+    template <class Set>
+    std::size_t count_cells(Set&& global_set, std::size_t max_count = std::numeric_limits<std::size_t>::max())
+    {
+        constexpr std::size_t dim = std::decay_t<Set>::dim;
+        xt::xtensor_fixed<int, xt::xshape<dim - 1>> index;
+        std::size_t count = 0;
+
+        auto func = [&](const auto& interval, const auto&)
+        {
+            count += static_cast<std::size_t>(interval.size());
+            return count >= max_count;
+        };
+
+        if (detail::may_exist(global_set))
+        {
+            detail::apply_impl<dim>(std::forward<Set>(global_set), func, index);
+        }
+        return count;
+    }
+
+    /**
+     * Number of intervals given by the traversal of the set (adjacent
+     * intervals are not merged), with the same early exit as count_cells.
+     */
+    template <class Set>
+    std::size_t count_intervals(Set&& global_set, std::size_t max_count = std::numeric_limits<std::size_t>::max())
+    {
+        constexpr std::size_t dim = std::decay_t<Set>::dim;
+        xt::xtensor_fixed<int, xt::xshape<dim - 1>> index;
+        std::size_t count = 0;
+
+        auto func = [&](const auto&, const auto&)
+        {
+            return ++count >= max_count;
+        };
+
+        if (detail::may_exist(global_set))
+        {
+            detail::apply_impl<dim>(std::forward<Set>(global_set), func, index);
+        }
+        return count;
+    }
+
+    namespace detail
+    {
+        template <class Set>
+        struct is_binary_list_op : std::false_type
+        {
+        };
+
+        template <class Op, class S1, class S2>
+        struct is_binary_list_op<SetTraverser<Op, S1, S2>>
+            : std::bool_constant<(std::is_same_v<Op, IntersectionOp> || std::is_same_v<Op, UnionOp> || std::is_same_v<Op, DifferenceOp>)
+                                 && IsIntervalListVisitor<S1> && IsIntervalListVisitor<S2>>
+        {
+        };
+
+        template <class Set>
+        constexpr bool is_binary_list_op_v = is_binary_list_op<std::decay_t<Set>>::value;
+
+        template <class Set>
+        struct is_same_list_op : std::false_type
+        {
+        };
+
+        template <class Op, class S1, class... S>
+        struct is_same_list_op<SetTraverser<Op, S1, S...>>
+            : std::bool_constant<IsIntervalListVisitor<S1> && (std::is_same_v<S1, S> && ...)>
+        {
+        };
+
+        template <class Set>
+        constexpr bool is_same_list_op_v = is_same_list_op<std::decay_t<Set>>::value;
+
+        /**
+         * Traversal of an operation whose result is one of its operands (see
+         * Subset::reduce_operands): only the intervals of this operand are read.
+         */
+        template <class Set, class StartEnd, class Func>
+        bool apply_single(Set& set, StartEnd& start_and_stop, Func& func)
+        {
+            using interval_t = typename Set::interval_t;
+
+            const auto i  = *set.single_operand();
+            auto& operand = tuple_at(set.sets(), i);
+
+            // the start and end functions may differ in type (difference)
+            bool stop = false;
+            visit_at(start_and_stop,
+                     i,
+                     [&](auto& fct)
+                     {
+                         typename std::decay_t<decltype(operand)>::interval_t interval;
+                         interval_t result;
+                         while (operand.next_merged_interval(fct, interval))
+                         {
+                             result.start     = interval.start;
+                             result.end       = interval.end;
+                             auto true_result = set.shift() >= 0 ? result >> static_cast<std::size_t>(set.shift())
+                                                                 : result << -static_cast<std::size_t>(set.shift());
+                             if (func(true_result))
+                             {
+                                 stop = true;
+                                 return;
+                             }
+                         }
+                     });
+            return stop;
+        }
+
+        /**
+         * Intersection, union or difference of two interval lists by a
+         * two-pointer merge.
+         *
+         * Both lists are sorted and their intervals are disjoint and not
+         * adjacent once merged by the visitors: the runs are built directly
+         * from the pairs of intervals, without going through every start and
+         * end event. The runs and the calls to func are the same as with the
+         * generic traversal.
+         */
+        template <class Set, class StartEnd, class Func>
+        bool apply_binary(Set& set, StartEnd& start_and_stop, Func& func)
+        {
+            using operator_t = typename Set::operator_t;
+            using interval_t = typename Set::interval_t;
+
+            auto& lhs = std::get<0>(set.sets());
+            auto& rhs = std::get<1>(set.sets());
+
+            auto& lhs_fct = std::get<0>(start_and_stop);
+            auto& rhs_fct = std::get<1>(start_and_stop);
+
+            typename std::decay_t<decltype(lhs)>::interval_t a;
+            typename std::decay_t<decltype(rhs)>::interval_t b;
+
+            interval_t result;
+            auto emit = [&](auto start, auto end)
+            {
+                result.start = start;
+                result.end   = end;
+                auto true_result = set.shift() >= 0 ? result >> static_cast<std::size_t>(set.shift())
+                                                    : result << -static_cast<std::size_t>(set.shift());
+                return func(true_result);
+            };
+
+            bool has_a = lhs.next_merged_interval(lhs_fct, a);
+            bool has_b = rhs.next_merged_interval(rhs_fct, b);
+
+            if constexpr (std::is_same_v<operator_t, IntersectionOp>)
+            {
+                while (has_a && has_b)
+                {
+                    auto start = std::max(a.start, b.start);
+                    auto end   = std::min(a.end, b.end);
+                    if (start < end && emit(start, end))
+                    {
+                        return true;
+                    }
+                    // the interval ending first can't intersect anything else
+                    auto a_end = a.end;
+                    auto b_end = b.end;
+                    if (a_end <= b_end)
+                    {
+                        has_a = lhs.next_merged_interval(lhs_fct, a);
+                    }
+                    if (b_end <= a_end)
+                    {
+                        has_b = rhs.next_merged_interval(rhs_fct, b);
+                    }
+                }
+            }
+            else if constexpr (std::is_same_v<operator_t, UnionOp>)
+            {
+                if (!has_a && !has_b)
+                {
+                    return false;
+                }
+                // the run being built, extended while the next interval touches it
+                auto take_a = has_a && (!has_b || a.start <= b.start);
+                auto start  = take_a ? a.start : b.start;
+                auto end    = take_a ? a.end : b.end;
+                while (has_a || has_b)
+                {
+                    take_a = has_a && (!has_b || a.start <= b.start);
+                    const auto& next = take_a ? a : b;
+                    if (next.start <= end)
+                    {
+                        end = std::max(end, next.end);
+                    }
+                    else
+                    {
+                        if (emit(start, end))
+                        {
+                            return true;
+                        }
+                        start = next.start;
+                        end   = next.end;
+                    }
+                    if (take_a)
+                    {
+                        has_a = lhs.next_merged_interval(lhs_fct, a);
+                    }
+                    else
+                    {
+                        has_b = rhs.next_merged_interval(rhs_fct, b);
+                    }
+                }
+                return emit(start, end);
+            }
+            else
+            {
+                while (has_a)
+                {
+                    auto start = a.start;
+                    // skip what is removed before the current interval
+                    while (has_b && b.end <= start)
+                    {
+                        has_b = rhs.next_merged_interval(rhs_fct, b);
+                    }
+                    while (has_b && b.start < a.end)
+                    {
+                        if (start < b.start && emit(start, b.start))
+                        {
+                            return true;
+                        }
+                        start = std::max(start, b.end);
+                        if (b.end > a.end)
+                        {
+                            // b may also remove a part of the next interval
+                            break;
+                        }
+                        has_b = rhs.next_merged_interval(rhs_fct, b);
+                    }
+                    if (start < a.end && emit(start, a.end))
+                    {
+                        return true;
+                    }
+                    has_a = lhs.next_merged_interval(lhs_fct, a);
+                }
+            }
+            return false;
+        }
+    }
+
     template <class Set, class StartEnd, class Func>
         requires IsSetOp<Set> || IsIntervalListVisitor<Set>
     bool apply(Set&& set, StartEnd&& start_and_stop, Func&& func)
@@ -86,6 +413,18 @@ namespace samurai
         using interval_t = typename std::decay_t<Set>::interval_t;
         using value_t    = typename interval_t::value_t;
 
+        if constexpr (detail::is_same_list_op_v<Set>)
+        {
+            if (set.single_operand())
+            {
+                return detail::apply_single(set, start_and_stop, func);
+            }
+        }
+        if constexpr (detail::is_binary_list_op_v<Set>)
+        {
+            return detail::apply_binary(set, start_and_stop, func);
+        }
+
         interval_t result;
         int r_ipos = 0;
         set.next(0, std::forward<StartEnd>(start_and_stop));
@@ -118,4 +457,138 @@ namespace samurai
         }
         return false;
     }
+
+    namespace detail
+    {
+        /**
+         * The positions along the last dimension where the set is not empty.
+         *
+         * The state of the set is then ready for apply_impl<dim - 1>, which can
+         * traverse each position independently on a copy of the set.
+         */
+        template <class Set, class Container>
+        auto outer_positions(Set& global_set, Container& index)
+        {
+            constexpr std::size_t dim = std::decay_t<Set>::dim;
+            using value_t             = typename std::decay_t<Set>::interval_t::value_t;
+
+            std::vector<value_t> positions;
+
+            auto set            = global_set.template get_local_set<dim>(global_set.level(), index);
+            auto start_and_stop = global_set.template get_start_and_stop_function<dim>();
+            apply(set,
+                  start_and_stop,
+                  [&positions](const auto& interval)
+                  {
+                      for (auto i = interval.start; i < interval.end; ++i)
+                      {
+                          positions.push_back(i);
+                      }
+                      return false;
+                  });
+            return positions;
+        }
+
+#ifdef SAMURAI_WITH_PARALLEL
+        /**
+         * Traversal of apply<Run::Parallel>: the positions along the last
+         * dimension are split into chunks traversed concurrently, each one on
+         * its own copy of the set and with its own function make_func().
+         */
+        template <class Set, class MakeFunc>
+        void parallel_apply_impl(Set& global_set, MakeFunc&& make_func)
+        {
+            constexpr std::size_t dim = std::decay_t<Set>::dim;
+
+            xt::xtensor_fixed<int, xt::xshape<dim - 1>> index;
+            const auto positions = outer_positions(global_set, index);
+
+            // a few chunks per thread to balance the rows of uneven sizes
+            const std::size_t nb_chunks = std::min(positions.size(), 4 * parallel::max_threads());
+
+            parallel::for_each_index(nb_chunks,
+                                     [&](std::size_t c)
+                                     {
+                                         auto local_set   = global_set;
+                                         auto local_index = index;
+                                         auto func        = make_func();
+                                         for (std::size_t r = c * positions.size() / nb_chunks;
+                                              r < (c + 1) * positions.size() / nb_chunks;
+                                              ++r)
+                                         {
+                                             local_index[dim - 2] = positions[r];
+                                             apply_impl<dim - 1>(local_set, func, local_index);
+                                         }
+                                     });
+        }
+#endif
+    }
+
+    /**
+     * Same as apply, with run_type = Run::Parallel the positions along the
+     * last dimension are split into chunks traversed concurrently, each one on
+     * its own copy of the set.
+     *
+     * user_func is then called concurrently for different positions along the
+     * last dimension: it is race-free if it only writes to the cells of the
+     * interval it is given. Nested in a parallel region, or without parallel
+     * backend, the traversal is sequential.
+     *
+     * The chunks are handed out dynamically: a thread may compute cells whose
+     * memory was first touched by another one (see detail::first_touch).
+     */
+    template <Run run_type, class Set, class Func>
+    void apply(Set&& global_set, Func&& user_func)
+    {
+#ifdef SAMURAI_WITH_PARALLEL
+        constexpr std::size_t dim = std::decay_t<Set>::dim;
+
+        if constexpr (run_type == Run::Parallel && dim > 1)
+        {
+            if (detail::may_exist(global_set) && !parallel::in_parallel())
+            {
+                detail::parallel_apply_impl(global_set,
+                                            [&]()
+                                            {
+                                                return [&](const auto& interval, const auto& yz)
+                                                {
+                                                    user_func(interval, yz);
+                                                    return false;
+                                                };
+                                            });
+                return;
+            }
+        }
+#endif
+        apply(std::forward<Set>(global_set), std::forward<Func>(user_func));
+    }
+
+    /**
+     * Same as apply_rows, with run_type = Run::Parallel the rows are
+     * traversed concurrently as in apply<Run::Parallel>: row_func is then
+     * called concurrently for different positions along the last dimension.
+     */
+    template <Run run_type, class Set, class Func>
+    void apply_rows(Set&& global_set, Func&& row_func)
+    {
+#ifdef SAMURAI_WITH_PARALLEL
+        constexpr std::size_t dim = std::decay_t<Set>::dim;
+        using interval_t          = typename std::decay_t<Set>::interval_t;
+
+        if constexpr (run_type == Run::Parallel && dim > 1)
+        {
+            if (detail::may_exist(global_set) && !parallel::in_parallel())
+            {
+                // each chunk gathers its rows in its own buffer
+                detail::parallel_apply_impl(global_set,
+                                            [&]()
+                                            {
+                                                return detail::row_function<Func, interval_t>{row_func, {}};
+                                            });
+                return;
+            }
+        }
+#endif
+        apply_rows(std::forward<Set>(global_set), std::forward<Func>(row_func));
+    }
 }
@@ -0,0 +1,136 @@
+// Copyright 2018-2025 the samurai's authors
+// SPDX-License-Identifier:  BSD-3-Clause
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace samurai
+{
+    /** @class BoundingBox
+     *  @brief Conservative bounds of a set, used to skip the traversal of the empty subsets.
+     *
+     * The bounds are given in the units of the level 0 (an index i at the
+     * level l is i / 2^l), so that sets at different levels can be compared.
+     * The cells of the set are inside [min, max[ in each direction, the
+     * converse is not true.
+     */
+    template <std::size_t dim>
+    struct BoundingBox
+    {
+        std::array<double, dim> min;
+        std::array<double, dim> max;
+
+        /// Bounds of a set which is not known.
+        static BoundingBox whole()
+        {
+            BoundingBox box;
+            box.min.fill(-std::numeric_limits<double>::infinity());
+            box.max.fill(std::numeric_limits<double>::infinity());
+            return box;
+        }
+
+        static BoundingBox empty_box()
+        {
+            BoundingBox box;
+            box.min.fill(std::numeric_limits<double>::infinity());
+            box.max.fill(-std::numeric_limits<double>::infinity());
+            return box;
+        }
+
+        /// Bounds of the cells between the indices min_indices and max_indices (excluded) at the given level.
+        template <class Array>
+        static BoundingBox from_indices(const Array& min_indices, const Array& max_indices, std::size_t level)
+        {
+            BoundingBox box;
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                box.min[d] = std::ldexp(static_cast<double>(min_indices[d]), -static_cast<int>(level));
+                box.max[d] = std::ldexp(static_cast<double>(max_indices[d]), -static_cast<int>(level));
+            }
+            return box;
+        }
+
+        bool empty() const
+        {
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                if (!(min[d] < max[d]))
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /// Bounds of the cells at the given level covering this box.
+        BoundingBox& project(std::size_t level)
+        {
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                min[d] = std::ldexp(std::floor(std::ldexp(min[d], static_cast<int>(level))), -static_cast<int>(level));
+                max[d] = std::ldexp(std::ceil(std::ldexp(max[d], static_cast<int>(level))), -static_cast<int>(level));
+            }
+            return *this;
+        }
+
+        /// Move the box by the given number of cells of the given level.
+        template <class Array>
+        BoundingBox& translate(const Array& t, std::size_t level)
+        {
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                min[d] += std::ldexp(static_cast<double>(t[d]), -static_cast<int>(level));
+                max[d] += std::ldexp(static_cast<double>(t[d]), -static_cast<int>(level));
+            }
+            return *this;
+        }
+
+        /// Enlarge the box by the given number of cells of the given level in each direction.
+        BoundingBox& enlarge(double width, std::size_t level)
+        {
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                min[d] -= std::ldexp(width, -static_cast<int>(level));
+                max[d] += std::ldexp(width, -static_cast<int>(level));
+            }
+            return *this;
+        }
+    };
+
+    template <std::size_t dim>
+    inline BoundingBox<dim> intersect(const BoundingBox<dim>& box_1, const BoundingBox<dim>& box_2)
+    {
+        BoundingBox<dim> box;
+        for (std::size_t d = 0; d < dim; ++d)
+        {
+            box.min[d] = std::max(box_1.min[d], box_2.min[d]);
+            box.max[d] = std::min(box_1.max[d], box_2.max[d]);
+        }
+        return box;
+    }
+
+    template <std::size_t dim>
+    inline BoundingBox<dim> hull(const BoundingBox<dim>& box_1, const BoundingBox<dim>& box_2)
+    {
+        if (box_1.empty())
+        {
+            return box_2;
+        }
+        if (box_2.empty())
+        {
+            return box_1;
+        }
+        BoundingBox<dim> box;
+        for (std::size_t d = 0; d < dim; ++d)
+        {
+            box.min[d] = std::min(box_1.min[d], box_2.min[d]);
+            box.max[d] = std::max(box_1.max[d], box_2.max[d]);
+        }
+        return box;
+    }
+}
@@ -10,6 +10,9 @@ namespace samurai
 {
     template <std::size_t dim, class interval_t>
     class LevelCellArray;
+
+    template <std::size_t dim, class interval_t>
+    class LevelCellArrayView;
     // }
 
     // namespace samurai::experimental
@@ -41,4 +44,7 @@ namespace samurai
 
     template <typename T>
     concept IsLCA = std::same_as<LevelCellArray<T::dim, typename T::interval_t>, T>;
+
+    template <typename T>
+    concept IsLCAView = std::same_as<LevelCellArrayView<T::dim, typename T::interval_t>, T>;
 }
@@ -4,11 +4,15 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <limits>
+#include <memory>
+#include <optional>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <xtensor/xfixed.hpp>
 
@@ -25,6 +29,26 @@ namespace samurai
     template <class Set, class Func>
     void apply(Set&& global_set, Func&& func);
 
+    template <class lca_t>
+        requires IsLCA<lca_t> || IsLCAView<lca_t>
+    struct Self;
+
+    namespace detail
+    {
+        template <class... S>
+        struct are_same_self : std::false_type
+        {
+        };
+
+        template <class lca_t, class... S>
+        struct are_same_self<Self<lca_t>, S...> : std::bool_constant<(std::is_same_v<Self<lca_t>, S> && ...)>
+        {
+        };
+
+        template <class... S>
+        constexpr bool are_same_self_v = are_same_self<std::decay_t<S>...>::value;
+    }
+
     template <class Op, class StartEndOp, class... S>
     class Subset
     {
@@ -48,6 +72,7 @@ namespace samurai
                     (args.ref_level(m_ref_level), ...);
                 },
                 m_s);
+            reduce_operands();
         }
 
         auto& on(auto level)
@@ -78,12 +103,44 @@ namespace samurai
             apply(*this, func);
         }
 
+        template <Run run_type, class... ApplyOp>
+        void apply_op(ApplyOp&&... op)
+        {
+            auto func = [&](auto& interval, auto& index)
+            {
+                (op(m_level, interval, index), ...);
+            };
+            apply<run_type>(*this, func);
+        }
+
         template <std::size_t d, class Func_goback_beg, class Func_goback_end>
         auto get_local_set(auto level, auto& index, Func_goback_beg&& goback_fct_beg, Func_goback_end&& goback_fct_end)
         {
             int shift = static_cast<int>(this->ref_level()) - static_cast<int>(this->level());
             m_start_end_op(m_level, m_min_level, m_ref_level);
 
+            if constexpr (detail::are_same_self_v<S...>)
+            {
+                if (m_single_operand)
+                {
+                    // the other operands are not read: they are replaced by copies of this one
+                    auto set = tuple_at(m_s, *m_single_operand)
+                                   .template get_local_set<d>(
+                                       level,
+                                       index,
+                                       m_start_end_op.template goback<d + 1>(std::forward<Func_goback_beg>(goback_fct_beg)),
+                                       m_start_end_op.template goback<d + 1, true>(std::forward<Func_goback_end>(goback_fct_end)));
+                    auto traverser = std::apply(
+                        [this, shift, &set](const auto&... args)
+                        {
+                            return SetTraverser(shift, get_operator<d>(m_operator), (static_cast<void>(args), decltype(set)(set))...);
+                        },
+                        m_s);
+                    traverser.single_operand(*m_single_operand);
+                    return traverser;
+                }
+            }
+
             return std::apply(
                 [this, &index, shift, level, &goback_fct_beg, &goback_fct_end](auto&&... args)
                 {
@@ -166,8 +223,27 @@ namespace samurai
             return empty_check(*this);
         }
 
+        std::size_t count_cells(std::size_t max_count = std::numeric_limits<std::size_t>::max())
+        {
+            return samurai::count_cells(*this, max_count);
+        }
+
+        std::size_t count_intervals(std::size_t max_count = std::numeric_limits<std::size_t>::max())
+        {
+            return samurai::count_intervals(*this, max_count);
+        }
+
         bool exist() const
         {
+            if constexpr (std::is_same_v<Op, DifferenceOp> && detail::are_same_self_v<S...>)
+            {
+                // a \ a is empty, unless a is projected on a coarser level
+                const auto& operand = std::get<0>(m_s);
+                if (m_same_operands && m_min_level >= operand.m_lca.level() && operand.m_min_level >= operand.m_lca.level())
+                {
+                    return false;
+                }
+            }
             return std::apply(
                 [this](auto&&... args)
                 {
@@ -176,18 +252,81 @@ namespace samurai
                 m_s);
         }
 
+        /// Conservative bounds of the set: the traversal is skipped if they are empty.
+        auto bounding_box() const
+        {
+            return bounding_box(m_min_level);
+        }
+
+        /// Bounds of the set when it is read through a set projected at the level min_level.
+        auto bounding_box(std::size_t min_level) const
+        {
+            // the operands are compared once projected at the coarsest level of the expression
+            min_level = std::min(min_level, m_min_level);
+            return std::apply(
+                [this, min_level](const auto&... args)
+                {
+                    return m_operator.bounding_box(
+                        m_start_end_op.bounding_box(args.bounding_box(min_level), args.level(), m_level, min_level)...);
+                },
+                m_s);
+        }
+
       protected:
 
+        /**
+         * Look for trivial forms when the operands are all LevelCellArrays of
+         * the same type: intersection(a, a), union_(a, a), union_(a, empty),
+         * difference(a, empty) are given by a alone, and difference(a, a) is
+         * empty at the levels of a and finer. The traversal then reads a
+         * single operand, or nothing.
+         */
+        void reduce_operands()
+        {
+            if constexpr (sizeof...(S) > 1 && detail::are_same_self_v<S...>)
+            {
+                std::apply(
+                    [this](const auto& arg, const auto&... args)
+                    {
+                        const bool same_operands = (arg.is_same_set(args) && ...);
+
+                        if constexpr (std::is_same_v<Op, DifferenceOp>)
+                        {
+                            m_same_operands = same_operands;
+                            if (!same_operands && !(args.exist() || ...))
+                            {
+                                m_single_operand = 0;
+                            }
+                        }
+                        else if (same_operands)
+                        {
+                            m_single_operand = 0;
+                        }
+                        else if constexpr (std::is_same_v<Op, UnionOp>)
+                        {
+                            const std::array<bool, sizeof...(S)> exist{arg.exist(), args.exist()...};
+                            if (std::count(exist.begin(), exist.end(), true) == 1)
+                            {
+                                m_single_operand = static_cast<std::size_t>(std::find(exist.begin(), exist.end(), true) - exist.begin());
+                            }
+                        }
+                    },
+                    m_s);
+            }
+        }
+
         Op m_operator;
         StartEndOp m_start_end_op;
         set_type m_s;
         std::size_t m_ref_level;
         std::size_t m_level;
         std::size_t m_min_level;
+        std::optional<std::size_t> m_single_operand;
+        bool m_same_operands = false;
     };
 
     template <class lca_t>
-        requires IsLCA<lca_t>
+        requires IsLCA<lca_t> || IsLCAView<lca_t>
     struct Self
     {
         static constexpr std::size_t dim = lca_t::dim;
@@ -218,6 +357,16 @@ namespace samurai
             apply(*this, func);
         }
 
+        template <Run run_type, class... ApplyOp>
+        void apply_op(ApplyOp&&... op)
+        {
+            auto func = [&](auto& interval, auto& index)
+            {
+                (op(m_level, interval, index), ...);
+            };
+            apply<run_type>(*this, func);
+        }
+
         template <std::size_t d, class Func_goback_beg, class Func_goback_end>
         auto get_local_set(auto level, auto& index, Func_goback_beg&& goback_fct_beg, Func_goback_end&& goback_fct_end)
         {
@@ -439,12 +588,65 @@ namespace samurai
             return !m_lca.empty();
         }
 
+        auto bounding_box() const
+        {
+            return bounding_box(m_min_level);
+        }
+
+        auto bounding_box(std::size_t min_level) const
+        {
+            using box_t = BoundingBox<dim>;
+
+            if constexpr (IsLCA<lca_t>)
+            {
+                // the bounds of a LevelCellArray are cached
+                if (m_lca.empty())
+                {
+                    return box_t::empty_box();
+                }
+                return m_func.bounding_box(box_t::from_indices(m_lca.min_indices(), m_lca.max_indices(), m_lca.level()),
+                                           m_lca.level(),
+                                           m_level,
+                                           std::min(min_level, m_min_level));
+            }
+            else
+            {
+                return box_t::whole();
+            }
+        }
+
+        /// True if other reads the same cells at the same levels.
+        bool is_same_set(const Self& other) const
+        {
+            if (m_lca.level() != other.m_lca.level() || m_level != other.m_level || m_ref_level != other.m_ref_level
+                || m_min_level != other.m_min_level)
+            {
+                return false;
+            }
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                if (m_lca[d].data() != other.m_lca[d].data() || m_lca[d].size() != other.m_lca[d].size())
+                {
+                    return false;
+                }
+            }
+            for (std::size_t d = 1; d < dim; ++d)
+            {
+                if (m_lca.offsets(d).data() != other.m_lca.offsets(d).data())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
         bool empty() const
         {
             return !m_lca.empty();
         }
 
-        const lca_t& m_lca;
+        // a view is light and may be a temporary: it is stored by value
+        std::conditional_t<IsLCAView<lca_t>, const lca_t, const lca_t&> m_lca;
         std::size_t m_level;
         std::size_t m_ref_level;
         std::size_t m_min_level;
@@ -453,6 +655,30 @@ namespace samurai
         std::array<std::vector<std::array<std::size_t, 2>>, dim> m_offsets;
     };
 
+    namespace detail
+    {
+        template <class lca_t>
+        struct lca_owner
+        {
+            std::shared_ptr<const lca_t> m_owned;
+        };
+    }
+
+    /**
+     * Self over a LevelCellArray computed for an expression (see expand and
+     * contract): the copies of the expression share it.
+     */
+    template <class lca_t>
+    struct OwnedSelf : private detail::lca_owner<lca_t>
+                     , public Self<lca_t>
+    {
+        explicit OwnedSelf(std::shared_ptr<const lca_t> lca)
+            : detail::lca_owner<lca_t>{std::move(lca)}
+            , Self<lca_t>(*this->m_owned)
+        {
+        }
+    };
+
     namespace detail
     {
         template <std::size_t dim, class interval_t>
@@ -467,6 +693,13 @@ namespace samurai
             return Self<LevelCellArray<dim, interval_t>>(lca);
         }
 
+        template <class View>
+            requires IsLCAView<std::decay_t<View>>
+        auto transform(View&& view)
+        {
+            return Self<std::decay_t<View>>(view);
+        }
+
         template <class E>
         auto transform(E&& e)
         {
@@ -532,30 +765,268 @@ namespace samurai
         return Self<std::decay_t<lca_t>>(std::forward<lca_t>(lca));
     }
 
-    template <std::size_t direction_index, class SubsetOrLCA>
-    auto contract_rec(const SubsetOrLCA& set, int width, const std::array<bool, SubsetOrLCA::dim>& contract_directions)
+    namespace detail
     {
-        static constexpr std::size_t dim = SubsetOrLCA::dim;
-        if constexpr (direction_index < dim)
+        /// An x-interval of a set with its coordinates along the other directions.
+        template <std::size_t dim, class value_t>
+        struct row_interval
+        {
+            std::array<value_t, dim - 1> yz;
+            value_t start;
+            value_t end;
+        };
+
+        /**
+         * Dilation (erode = false) or erosion (erode = true) of a set by width
+         * cells along the direction axis > 0, in a single pass.
+         *
+         * The rows which only differ by their coordinate along axis are
+         * grouped. In each group, the row r of the result is given by a sweep
+         * over the start and end events of the rows in the window
+         * [r - width, r + width]: a cell is kept if one of these rows covers it
+         * (dilation), or if all of them do (erosion).
+         */
+        template <std::size_t dim, class value_t>
+        auto window_pass(std::vector<row_interval<dim, value_t>>& rows, std::size_t axis, int width, bool erode)
         {
-            using direction_t = xt::xtensor_fixed<int, xt::xshape<dim>>;
+            using row_interval_t = row_interval<dim, value_t>;
+
+            const std::size_t a = axis - 1;
+
+            // -1, 0 or 1 as the group of lhs is before, the same as or after the group of rhs
+            auto compare_group = [a](const row_interval_t& lhs, const row_interval_t& rhs)
+            {
+                for (std::size_t d = dim - 1; d-- > 0;)
+                {
+                    if (d != a && lhs.yz[d] != rhs.yz[d])
+                    {
+                        return lhs.yz[d] < rhs.yz[d] ? -1 : 1;
+                    }
+                }
+                return 0;
+            };
+            std::sort(rows.begin(),
+                      rows.end(),
+                      [&](const row_interval_t& lhs, const row_interval_t& rhs)
+                      {
+                          auto c = compare_group(lhs, rhs);
+                          return c != 0 ? c < 0 : std::tie(lhs.yz[a], lhs.start) < std::tie(rhs.yz[a], rhs.start);
+                      });
+
+            // the rows of a group: their coordinate along axis and their range in rows
+            struct position_t
+            {
+                value_t value;
+                std::size_t first;
+                std::size_t last;
+            };
+
+            std::vector<row_interval_t> result;
+            std::vector<position_t> positions;
+            std::vector<std::pair<value_t, int>> events;
+
+            auto sweep = [&](const row_interval_t& group, value_t r, std::size_t lo, std::size_t hi)
+            {
+                events.clear();
+                for (std::size_t p = lo; p < hi; ++p)
+                {
+                    for (std::size_t i = positions[p].first; i < positions[p].last; ++i)
+                    {
+                        events.emplace_back(rows[i].start, 1);
+                        events.emplace_back(rows[i].end, -1);
+                    }
+                }
+                std::sort(events.begin(), events.end());
+
+                const int threshold = erode ? static_cast<int>(hi - lo) : 1;
+                row_interval_t out{group.yz, 0, 0};
+                out.yz[a]     = r;
+                int coverage  = 0;
+                std::size_t e = 0;
+                while (e < events.size())
+                {
+                    // the events at the same coordinate are applied together: the touching intervals are merged
+                    const auto x      = events[e].first;
+                    const bool was_in = coverage >= threshold;
+                    for (; e < events.size() && events[e].first == x; ++e)
+                    {
+                        coverage += events[e].second;
+                    }
+                    const bool is_in = coverage >= threshold;
+                    if (!was_in && is_in)
+                    {
+                        out.start = x;
+                    }
+                    else if (was_in && !is_in)
+                    {
+                        out.end = x;
+                        result.push_back(out);
+                    }
+                }
+            };
+
+            for (std::size_t g_first = 0; g_first < rows.size();)
+            {
+                std::size_t g_last = g_first;
+                positions.clear();
+                while (g_last < rows.size() && compare_group(rows[g_first], rows[g_last]) == 0)
+                {
+                    if (positions.empty() || positions.back().value != rows[g_last].yz[a])
+                    {
+                        positions.push_back({rows[g_last].yz[a], g_last, g_last});
+                    }
+                    positions.back().last = ++g_last;
+                }
 
-            auto contracted_in_other_dirs = contract_rec<direction_index + 1>(set, width, contract_directions);
-            direction_t dir;
-            dir.fill(0);
-            dir[direction_index] = contract_directions[direction_index] ? width : 0;
+                // the window of r is positions[lo, hi): both bounds only move forward
+                std::size_t lo = 0;
+                std::size_t hi = 0;
+                auto window    = [&](value_t r)
+                {
+                    while (lo < positions.size() && positions[lo].value < r - width)
+                    {
+                        ++lo;
+                    }
+                    while (hi < positions.size() && positions[hi].value <= r + width)
+                    {
+                        ++hi;
+                    }
+                };
 
-            return intersection(contracted_in_other_dirs, translate(set, dir), translate(set, -dir));
+                if (erode)
+                {
+                    // all the rows of the window must exist
+                    for (const auto& position : positions)
+                    {
+                        window(position.value);
+                        if (hi - lo == static_cast<std::size_t>(2 * width + 1))
+                        {
+                            sweep(rows[g_first], position.value, lo, hi);
+                        }
+                    }
+                }
+                else
+                {
+                    auto r = std::numeric_limits<value_t>::lowest();
+                    for (const auto& position : positions)
+                    {
+                        for (r = std::max(r, static_cast<value_t>(position.value - width)); r <= position.value + width; ++r)
+                        {
+                            window(r);
+                            sweep(rows[g_first], r, lo, hi);
+                        }
+                    }
+                }
+                g_first = g_last;
+            }
+            return result;
         }
-        else
+
+        /**
+         * The set expanded (or contracted) along the directions above x,
+         * computed once by a window pass per direction. Along x, the
+         * intervals are widened (or shrunk) by the start and end functions
+         * of the returned expression.
+         */
+        template <class SubsetOrLCA>
+        auto expand_or_contract(const SubsetOrLCA& set, std::size_t width, const std::array<bool, SubsetOrLCA::dim>& directions, bool erode)
         {
-            return set;
+            static constexpr std::size_t dim = SubsetOrLCA::dim;
+            using interval_t                 = typename SubsetOrLCA::interval_t;
+            using value_t                    = typename interval_t::value_t;
+            using lca_t                      = LevelCellArray<dim, interval_t>;
+
+            const int w = static_cast<int>(width);
+
+            bool along_other_directions = false;
+            for (std::size_t d = 1; d < dim; ++d)
+            {
+                along_other_directions = along_other_directions || (directions[d] && w > 0);
+            }
+
+            std::shared_ptr<const lca_t> lca;
+            if constexpr (IsLCA<SubsetOrLCA>)
+            {
+                if (!along_other_directions)
+                {
+                    // the LevelCellArray is read in place: the expression doesn't own it
+                    lca = std::shared_ptr<const lca_t>(std::shared_ptr<const lca_t>(), &set);
+                }
+            }
+            if (!lca)
+            {
+                auto operand = transform(set);
+                auto result  = std::make_shared<lca_t>(operand.level());
+
+                if constexpr (dim > 1)
+                {
+                    if (along_other_directions)
+                    {
+                        using row_interval_t = row_interval<dim, value_t>;
+
+                        std::vector<row_interval_t> rows;
+                        apply(operand,
+                              [&rows](const auto& interval, const auto& yz)
+                              {
+                                  row_interval_t row{{}, interval.start, interval.end};
+                                  std::copy(yz.cbegin(), yz.cend(), row.yz.begin());
+                                  rows.push_back(row);
+                              });
+                        for (std::size_t d = 1; d < dim; ++d)
+                        {
+                            if (directions[d])
+                            {
+                                rows = window_pass(rows, d, w, erode);
+                            }
+                        }
+
+                        // the rows are added in the order of the LevelCellArray
+                        std::sort(rows.begin(),
+                                  rows.end(),
+                                  [](const row_interval_t& lhs, const row_interval_t& rhs)
+                                  {
+                                      for (std::size_t d = dim - 1; d-- > 0;)
+                                      {
+                                          if (lhs.yz[d] != rhs.yz[d])
+                                          {
+                                              return lhs.yz[d] < rhs.yz[d];
+                                          }
+                                      }
+                                      return lhs.start < rhs.start;
+                                  });
+                        xt::xtensor_fixed<value_t, xt::xshape<dim - 1>> yz;
+                        for (const auto& row : rows)
+                        {
+                            std::copy(row.yz.cbegin(), row.yz.cend(), yz.begin());
+                            result->add_interval_back({row.start, row.end}, yz);
+                        }
+                    }
+                }
+                if (!along_other_directions)
+                {
+                    apply(operand,
+                          [&result](const auto& interval, const auto& yz)
+                          {
+                              result->add_interval_back(interval, yz);
+                          });
+                }
+                lca = std::move(result);
+            }
+
+            const int x_width = directions[0] ? (erode ? -w : w) : 0;
+            return Subset(SelfOp(), start_end_expand_function<dim>(x_width), OwnedSelf<lca_t>(std::move(lca)));
         }
     }
 
     /**
      * @brief Contract a set in the specified directions.
      *
+     * The result is the erosion of the set by a box of half-width width
+     * along the contracted directions: a cell is kept if all the cells at a
+     * distance of at most width are in the set. Along x, the intervals are
+     * shrunk by the start and end functions. Along each other direction, the
+     * set is computed once by a window pass over its rows.
+     *
      * @tparam SubsetOrLCA The type of the set to contract.
      * @param set The set or LevelCellArray to contract.
      * @param width The contraction width.
@@ -565,7 +1036,7 @@ namespace samurai
     template <class SubsetOrLCA>
     auto contract(const SubsetOrLCA& set, std::size_t width, const std::array<bool, SubsetOrLCA::dim>& contract_directions)
     {
-        return contract_rec<0>(set, static_cast<int>(width), contract_directions);
+        return detail::expand_or_contract(set, width, contract_directions, true);
     }
 
     /**
@@ -585,4 +1056,42 @@ namespace samurai
         std::fill(contract_directions.begin(), contract_directions.end(), true);
         return contract(set, width, contract_directions);
     }
+
+    /**
+     * @brief Expand a set in the specified directions.
+     *
+     * The result is the dilation of the set by a box of half-width width
+     * along the expanded directions: a cell is added if a cell of the set is
+     * at a distance of at most width. Along x, the intervals are widened by
+     * the start and end functions. Along each other direction, the set is
+     * computed once by a window pass over its rows. For width 1, it is
+     * nestedExpand.
+     *
+     * @tparam SubsetOrLCA The type of the set to expand.
+     * @param set The set or LevelCellArray to expand.
+     * @param width The expansion width.
+     * @param expand_directions An array indicating which directions to expand (true for expansion, false for no expansion).
+     * @return A new set that is expanded in the specified directions.
+     */
+    template <class SubsetOrLCA>
+    auto expand(const SubsetOrLCA& set, std::size_t width, const std::array<bool, SubsetOrLCA::dim>& expand_directions)
+    {
+        return detail::expand_or_contract(set, width, expand_directions, false);
+    }
+
+    /**
+     * @brief Expand a set in all directions.
+     *
+     * @tparam SubsetOrLCA The type of the set to expand.
+     * @param set The set or LevelCellArray to expand.
+     * @param width The expansion width.
+     * @return A new set that is expanded in all directions.
+     */
+    template <class SubsetOrLCA>
+    auto expand(const SubsetOrLCA& set, std::size_t width)
+    {
+        std::array<bool, SubsetOrLCA::dim> expand_directions;
+        std::fill(expand_directions.begin(), expand_directions.end(), true);
+        return expand(set, width, expand_directions);
+    }
 }
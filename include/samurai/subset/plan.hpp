@@ -0,0 +1,284 @@
+// Copyright 2018-2025 the samurai's authors
+// SPDX-License-Identifier:  BSD-3-Clause
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <xtensor/xfixed.hpp>
+
+#include "../algorithm.hpp"
+#include "../parallel.hpp"
+
+namespace samurai
+{
+    /** @class SubsetPlan
+     *  @brief Result of a subset expression recorded once to be replayed.
+     *
+     * The intervals and the coordinates along the other dimensions produced
+     * by the traversal of the expression are stored contiguously. Replaying
+     * them with apply_op gives the same calls as the expression itself,
+     * without running the traversal again.
+     *
+     * @tparam Dim        The dimension.
+     * @tparam TInterval  The interval type.
+     */
+    template <std::size_t Dim, class TInterval>
+    class SubsetPlan
+    {
+      public:
+
+        static constexpr auto dim = Dim;
+        using interval_t          = TInterval;
+        using value_t             = typename interval_t::value_t;
+        using index_t             = xt::xtensor_fixed<value_t, xt::xshape<dim - 1>>;
+
+        SubsetPlan() = default;
+
+        template <class Set>
+        explicit SubsetPlan(Set&& set);
+
+        template <class Func>
+        void operator()(Func&& func) const;
+
+        template <class... ApplyOp>
+        void apply_op(ApplyOp&&... op) const;
+
+        template <Run run_type, class... ApplyOp>
+        void apply_op(ApplyOp&&... op) const;
+
+        std::size_t level() const;
+        std::size_t nb_intervals() const;
+        bool empty() const;
+
+      private:
+
+        std::size_t m_level = 0;
+        std::vector<interval_t> m_intervals;
+        std::vector<index_t> m_indices;
+    };
+
+    /** @class SubsetPlanCache
+     *  @brief Plans of a mesh, built on demand and dropped when the mesh changes.
+     *
+     * The plans are identified by a name and a level, and are valid for one
+     * version of the mesh (see Mesh_base::subset_plan). A request with another
+     * version empties the cache.
+     *
+     * The requests may be concurrent: they are serialized by a mutex. A
+     * request with another version invalidates the plans returned before, so
+     * it must not be concurrent with their use.
+     */
+    template <std::size_t Dim, class TInterval>
+    class SubsetPlanCache
+    {
+      public:
+
+        using plan_t = SubsetPlan<Dim, TInterval>;
+        using key_t  = std::pair<std::string_view, std::size_t>;
+
+        SubsetPlanCache() = default;
+        SubsetPlanCache(const SubsetPlanCache& other);
+        SubsetPlanCache(SubsetPlanCache&& other);
+        SubsetPlanCache& operator=(const SubsetPlanCache& other);
+        SubsetPlanCache& operator=(SubsetPlanCache&& other);
+
+        template <class Set>
+        const plan_t& get(const key_t& key, std::size_t version, Set&& set);
+
+        void clear();
+
+      private:
+
+        /// The names are copied in the cache: the key of a request may refer to a temporary.
+        using stored_key_t = std::pair<std::string, std::size_t>;
+
+        struct key_less
+        {
+            using is_transparent = void;
+
+            template <class Key1, class Key2>
+            bool operator()(const Key1& lhs, const Key2& rhs) const
+            {
+                return key_t(lhs.first, lhs.second) < key_t(rhs.first, rhs.second);
+            }
+        };
+
+        std::size_t m_version = 0;
+        std::map<stored_key_t, plan_t, key_less> m_plans;
+        mutable std::mutex m_mutex;
+    };
+
+    namespace detail
+    {
+        /// A new value at each call, shared by all the meshes.
+        inline std::size_t new_mesh_generation()
+        {
+            static std::atomic<std::size_t> generation{0};
+            return ++generation;
+        }
+    }
+
+    ///////////////////////////////
+    // SubsetPlan implementation //
+    ///////////////////////////////
+
+    template <std::size_t Dim, class TInterval>
+    template <class Set>
+    inline SubsetPlan<Dim, TInterval>::SubsetPlan(Set&& set)
+        : m_level(set.level())
+    {
+        set(
+            [this](const auto& interval, const auto& index)
+            {
+                m_intervals.push_back(interval);
+                m_indices.push_back(index);
+            });
+    }
+
+    template <std::size_t Dim, class TInterval>
+    template <class Func>
+    inline void SubsetPlan<Dim, TInterval>::operator()(Func&& func) const
+    {
+        for (std::size_t i = 0; i < m_intervals.size(); ++i)
+        {
+            func(m_intervals[i], m_indices[i]);
+        }
+    }
+
+    template <std::size_t Dim, class TInterval>
+    template <class... ApplyOp>
+    inline void SubsetPlan<Dim, TInterval>::apply_op(ApplyOp&&... op) const
+    {
+        for (std::size_t i = 0; i < m_intervals.size(); ++i)
+        {
+            (op(m_level, m_intervals[i], m_indices[i]), ...);
+        }
+    }
+
+    /**
+     * With run_type = Run::Parallel, the intervals are replayed concurrently:
+     * it is race-free if the operators only write to the cells of the interval
+     * they are given.
+     */
+    template <std::size_t Dim, class TInterval>
+    template <Run run_type, class... ApplyOp>
+    inline void SubsetPlan<Dim, TInterval>::apply_op(ApplyOp&&... op) const
+    {
+        if constexpr (run_type == Run::Parallel)
+        {
+            parallel::for_each_index(
+                m_intervals.size(),
+                [&](std::size_t i)
+                {
+                    (op(m_level, m_intervals[i], m_indices[i]), ...);
+                },
+                64);
+        }
+        else
+        {
+            apply_op(std::forward<ApplyOp>(op)...);
+        }
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline std::size_t SubsetPlan<Dim, TInterval>::level() const
+    {
+        return m_level;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline std::size_t SubsetPlan<Dim, TInterval>::nb_intervals() const
+    {
+        return m_intervals.size();
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline bool SubsetPlan<Dim, TInterval>::empty() const
+    {
+        return m_intervals.empty();
+    }
+
+    ////////////////////////////////////
+    // SubsetPlanCache implementation //
+    ////////////////////////////////////
+
+    template <std::size_t Dim, class TInterval>
+    inline SubsetPlanCache<Dim, TInterval>::SubsetPlanCache(const SubsetPlanCache& other)
+    {
+        std::lock_guard<std::mutex> lock(other.m_mutex);
+        m_version = other.m_version;
+        m_plans   = other.m_plans;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline SubsetPlanCache<Dim, TInterval>::SubsetPlanCache(SubsetPlanCache&& other)
+    {
+        std::lock_guard<std::mutex> lock(other.m_mutex);
+        m_version = other.m_version;
+        m_plans   = std::move(other.m_plans);
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline auto SubsetPlanCache<Dim, TInterval>::operator=(const SubsetPlanCache& other) -> SubsetPlanCache&
+    {
+        if (this != &other)
+        {
+            std::scoped_lock lock(m_mutex, other.m_mutex);
+            m_version = other.m_version;
+            m_plans   = other.m_plans;
+        }
+        return *this;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline auto SubsetPlanCache<Dim, TInterval>::operator=(SubsetPlanCache&& other) -> SubsetPlanCache&
+    {
+        if (this != &other)
+        {
+            std::scoped_lock lock(m_mutex, other.m_mutex);
+            m_version = other.m_version;
+            m_plans   = std::move(other.m_plans);
+        }
+        return *this;
+    }
+
+    /**
+     * Return the plan of the given key, evaluating the set if it is not
+     * known for this version.
+     */
+    template <std::size_t Dim, class TInterval>
+    template <class Set>
+    inline auto SubsetPlanCache<Dim, TInterval>::get(const key_t& key, std::size_t version, Set&& set) -> const plan_t&
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (version != m_version)
+        {
+            m_plans.clear();
+            m_version = version;
+        }
+
+        auto it = m_plans.find(key);
+        if (it == m_plans.end())
+        {
+            it = m_plans.emplace(stored_key_t(key.first, key.second), plan_t(std::forward<Set>(set))).first;
+        }
+        return it->second;
+    }
+
+    template <std::size_t Dim, class TInterval>
+    inline void SubsetPlanCache<Dim, TInterval>::clear()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_plans.clear();
+        m_version = 0;
+    }
+} // namespace samurai
@@ -3,6 +3,7 @@
 
 #pragma once
 
+#include "bounding_box.hpp"
 #include "utils.hpp"
 
 namespace samurai
@@ -89,6 +90,13 @@ namespace samurai
             return new_f;
         }
 
+        /// Bounds of the set given the bounds box of its operand at the level operand_level.
+        template <class Box>
+        inline Box bounding_box(Box box, std::size_t /* operand_level */, std::size_t /* level */, std::size_t min_level) const
+        {
+            return box.project(min_level);
+        }
+
         std::size_t m_level;
         int m_shift;
         std::size_t m_min_level;
@@ -179,6 +187,18 @@ namespace samurai
             return new_f;
         }
 
+        /// Bounds of the set given the bounds box of its operand at the level operand_level.
+        template <class Box>
+        inline Box bounding_box(Box box, std::size_t operand_level, std::size_t level, std::size_t min_level) const
+        {
+            // the translation is given at the level of the operand along x and
+            // at the level of the set along the other directions: both are kept
+            auto other = box;
+            box.translate(m_t, operand_level);
+            other.translate(m_t, level);
+            return hull(box, other).project(min_level);
+        }
+
         std::size_t m_level;
         std::size_t m_min_level;
         std::size_t m_max_level;
@@ -267,9 +287,133 @@ namespace samurai
             return new_f;
         }
 
+        /// Bounds of the set given the bounds box of its operand at the level operand_level.
+        template <class Box>
+        inline Box bounding_box(Box box, std::size_t operand_level, std::size_t /* level */, std::size_t min_level) const
+        {
+            if (m_c < 0)
+            {
+                box.enlarge(-m_c, operand_level);
+            }
+            return box.project(min_level);
+        }
+
         std::size_t m_level;
         std::size_t m_min_level;
         std::size_t m_max_level;
         int m_c;
     };
+
+    /**
+     * Widen (width > 0) or shrink (width < 0) each interval along x by width
+     * cells at the level of the operand.
+     *
+     * The intervals which overlap once widened are merged and those which
+     * become empty are dropped by the visitor, so that the result is the
+     * dilation (resp. erosion) of the set along x. The other directions are
+     * left unchanged: the rows are not moved.
+     */
+    template <std::size_t dim>
+    struct start_end_expand_function
+    {
+        explicit start_end_expand_function(int width)
+            : m_level(0)
+            , m_min_level(0)
+            , m_max_level(0)
+            , m_width(width)
+        {
+        }
+
+        auto& operator()(auto level, auto min_level, auto max_level)
+        {
+            m_level     = level;
+            m_min_level = min_level;
+            m_max_level = max_level;
+            return *this;
+        }
+
+        template <std::size_t d, bool from_diff_op = false, class Func>
+        inline auto start(const Func& f) const
+        {
+            auto new_f = [&, f](auto level, auto i, auto dec)
+            {
+                int max2curr = static_cast<int>(m_max_level) - static_cast<int>(level);
+                int curr2min = static_cast<int>(level) - static_cast<int>(m_min_level);
+                int min2max  = static_cast<int>(m_max_level) - static_cast<int>(m_min_level);
+
+                if constexpr (from_diff_op)
+                {
+                    dec = (static_cast<std::size_t>(level) > m_level) ? 1 : 0;
+                }
+                int value = (((((i - dec) >> max2curr) - width<d>()) >> curr2min) + dec) << min2max;
+                return f(m_level, value, dec);
+            };
+            return new_f;
+        }
+
+        template <std::size_t d, bool from_diff_op = false, class Func>
+        inline auto end(const Func& f) const
+        {
+            auto new_f = [&, f](auto level, auto i, auto dec)
+            {
+                int max2curr = static_cast<int>(m_max_level) - static_cast<int>(level);
+                int curr2min = static_cast<int>(level) - static_cast<int>(m_min_level);
+                int min2max  = static_cast<int>(m_max_level) - static_cast<int>(m_min_level);
+
+                if constexpr (from_diff_op)
+                {
+                    dec = (static_cast<std::size_t>(level) > m_level) ? 0 : 1;
+                }
+                int value = (((((i - dec) >> max2curr) + width<d>()) >> curr2min) + dec) << min2max;
+                return f(m_level, value, dec);
+            };
+            return new_f;
+        }
+
+        template <std::size_t d, bool end = false, class Func>
+        inline auto goback(const Func& f) const
+        {
+            auto new_f = [&, f](auto level, auto i)
+            {
+                auto [prev_lev, v] = f(level, i);
+
+                auto min_shift = static_cast<int>(m_min_level) - static_cast<int>(prev_lev);
+                auto max_shift = static_cast<int>(m_level) - static_cast<int>(m_min_level);
+
+                if constexpr (end)
+                {
+                    i = end_shift(end_shift(v, min_shift), max_shift);
+                }
+                else
+                {
+                    i = start_shift(start_shift(v, min_shift), max_shift);
+                }
+
+                return std::make_pair(m_level, i);
+            };
+            return new_f;
+        }
+
+        /// Bounds of the set given the bounds box of its operand at the level operand_level.
+        template <class Box>
+        inline Box bounding_box(Box box, std::size_t operand_level, std::size_t /* level */, std::size_t min_level) const
+        {
+            if (m_width > 0)
+            {
+                box.enlarge(m_width, operand_level);
+            }
+            return box.project(min_level);
+        }
+
+        template <std::size_t d>
+        inline int width() const
+        {
+            return (d == 1) ? m_width : 0;
+        }
+
+        std::size_t m_level;
+        std::size_t m_min_level;
+        std::size_t m_max_level;
+        int m_width;
+    };
 }
@@ -4,9 +4,11 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
 #include <cstddef>
 #include <iterator>
 #include <limits>
+#include <tuple>
 
 // namespace samurai::experimental
 namespace samurai
@@ -110,4 +112,30 @@ namespace samurai
 
         zip_apply_impl(std::forward<F>(f), std::forward<Tuple1>(t1), std::forward<Tuple2>(t2), std::make_index_sequence<size1>{});
     }
+
+    /// Element i of a tuple whose elements all have the same type.
+    template <typename Tuple>
+    constexpr auto& tuple_at(Tuple& t, std::size_t i)
+    {
+        return std::apply(
+            [i](auto&... args) -> auto&
+            {
+                std::array elements{&args...};
+                return *elements[i];
+            },
+            t);
+    }
+
+    /// Call f on the element i of a tuple.
+    template <typename Tuple, typename F>
+    constexpr void visit_at(Tuple& t, std::size_t i, F&& f)
+    {
+        std::size_t k = 0;
+        std::apply(
+            [&](auto&... args)
+            {
+                ((k++ == i ? f(args) : void()), ...);
+            },
+            t);
+    }
 }
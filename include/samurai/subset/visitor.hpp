@@ -5,7 +5,9 @@
 
 #include <algorithm>
 #include <limits>
+#include <optional>
 
+#include "bounding_box.hpp"
 #include "utils.hpp"
 
 namespace samurai
@@ -17,21 +19,19 @@ namespace samurai
 
         using container_t = container_;
         using value_t     = typename container_t::value_type;
-        using iterator_t  = typename container_t::const_iterator;
+        // pointers so that the work list may be of another contiguous container type
+        using iterator_t = const value_t*;
 
         IntervalListRange(const container_t& data, std::ptrdiff_t start, std::ptrdiff_t end)
-            : m_data(data)
-            , m_work(data)
-            , m_begin(data.cbegin() + start)
-            , m_end(data.cbegin() + end)
+            : m_begin(data.data() + start)
+            , m_end(data.data() + end)
         {
         }
 
-        IntervalListRange(const container_t& data, const container_t& w)
-            : m_data(data)
-            , m_work(w)
-            , m_begin(w.cbegin())
-            , m_end(w.cend())
+        template <class work_container_t>
+        IntervalListRange(const container_t&, const work_container_t& w)
+            : m_begin(w.data())
+            , m_end(w.data() + w.size())
         {
         }
 
@@ -47,8 +47,6 @@ namespace samurai
 
       private:
 
-        const container_t& m_data;
-        const container_t& m_work;
         iterator_t m_begin;
         iterator_t m_end;
     };
@@ -138,10 +136,17 @@ namespace samurai
 
             auto i_start = start(m_first, start_fct);
             auto i_end   = end(m_first, end_fct);
+            // an interval can be emptied by a contraction: it is skipped
+            while (m_first + 1 != m_last && i_end <= i_start)
+            {
+                ++m_first;
+                i_start = start(m_first, start_fct);
+                i_end   = end(m_first, end_fct);
+            }
             while (m_first + 1 != m_last && i_end >= start(m_first + 1, start_fct))
             {
                 ++m_first;
-                i_end = end(m_first, end_fct);
+                i_end = std::max(i_end, end(m_first, end_fct));
             }
             m_current_interval = {i_start, i_end};
 
@@ -185,6 +190,33 @@ namespace samurai
             }
         }
 
+        /**
+         * Give the intervals of the list one after the other, transformed and
+         * merged as with next. The visitor must not be used with next after.
+         *
+         * @return false when the list is exhausted.
+         */
+        template <class StartEnd>
+        inline bool next_merged_interval(StartEnd& start_and_stop, interval_t& interval)
+        {
+            if (m_current == sentinel<value_t>)
+            {
+                return false;
+            }
+            if (m_current != std::numeric_limits<value_t>::min())
+            {
+                ++m_first;
+            }
+            if (m_first == m_last)
+            {
+                m_current = sentinel<value_t>;
+                return false;
+            }
+            next_interval(start_and_stop);
+            interval = m_current_interval;
+            return m_current != sentinel<value_t>;
+        }
+
       private:
 
         int m_lca_level;
@@ -204,6 +236,7 @@ namespace samurai
       public:
 
         static constexpr std::size_t dim = get_set_dim_v<S...>;
+        using operator_t                 = Operator;
         using set_type                   = std::tuple<S...>;
         using interval_t                 = get_interval_t<S...>;
 
@@ -249,6 +282,22 @@ namespace samurai
                 m_s);
         }
 
+        inline auto& sets()
+        {
+            return m_s;
+        }
+
+        /// The operand giving alone the result, if it is known.
+        inline const auto& single_operand() const
+        {
+            return m_single_operand;
+        }
+
+        inline void single_operand(std::size_t i)
+        {
+            m_single_operand = i;
+        }
+
         template <class StartEnd>
         void next(auto scan, StartEnd&& start_and_stop)
         {
@@ -266,6 +315,7 @@ namespace samurai
         int m_shift;
         Operator m_operator;
         set_type m_s;
+        std::optional<std::size_t> m_single_operand;
     };
 
     struct IntersectionOp
@@ -284,6 +334,13 @@ namespace samurai
         {
             return (args.exist() && ...);
         }
+
+        auto bounding_box(const auto& box, const auto&... boxes) const
+        {
+            auto output = box;
+            ((output = intersect(output, boxes)), ...);
+            return output;
+        }
     };
 
     struct UnionOp
@@ -302,6 +359,13 @@ namespace samurai
         {
             return (args.exist() || ...);
         }
+
+        auto bounding_box(const auto& box, const auto&... boxes) const
+        {
+            auto output = box;
+            ((output = hull(output, boxes)), ...);
+            return output;
+        }
     };
 
     struct DifferenceOp
@@ -320,6 +384,11 @@ namespace samurai
         {
             return arg.exist();
         }
+
+        auto bounding_box(const auto& box, const auto&...) const
+        {
+            return box;
+        }
     };
 
     struct Difference2Op
@@ -338,6 +407,11 @@ namespace samurai
         {
             return arg.exist();
         }
+
+        auto bounding_box(const auto& box, const auto&...) const
+        {
+            return box;
+        }
     };
 
     template <std::size_t d, class operator_t>
@@ -375,5 +449,10 @@ namespace samurai
         {
             return arg.exist();
         }
+
+        auto bounding_box(const auto& box) const
+        {
+            return box;
+        }
     };
 }
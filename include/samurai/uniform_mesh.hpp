@@ -159,7 +159,7 @@ namespace samurai
     inline void UniformMesh<Config>::update_sub_mesh()
     {
         cl_type cl{this->m_cells[mesh_id_t::cells].level()};
-        for_each_interval(this->m_cells[mesh_id_t::cells],
+        for_each_interval(std::as_const(this->m_cells[mesh_id_t::cells]),
                           [&](std::size_t, const auto& interval, const auto& index_yz)
                           {
                               static_nested_loop<dim - 1, -config::ghost_width, config::ghost_width + 1>(
@@ -184,11 +184,12 @@ namespace samurai
 
             if (mt != mesh_id_t::reference)
             {
-                for_each_interval(m_cells[mt],
-                                  [&](std::size_t, auto& i, auto& index)
-                                  {
-                                      i.index = m_cells[mesh_id_t::reference].get_interval(i, index).index;
-                                  });
+                const auto& reference = m_cells[mesh_id_t::reference];
+                m_cells[mt].update_index(
+                    [&](const auto& i, const auto& index)
+                    {
+                        return reference.get_interval(i, index).index;
+                    });
             }
         }
     }
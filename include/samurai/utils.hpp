@@ -4,10 +4,16 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <cstdint>
 #include <functional>
+#include <limits>
+#include <stdexcept>
 #include <tuple>
 #include <type_traits>
 
+#include <fmt/format.h>
+
 #include <xtensor/xfixed.hpp>
 
 namespace samurai
@@ -374,6 +380,41 @@ namespace samurai
         return static_cast<R>(static_cast<std::ptrdiff_t>(a) - static_cast<std::ptrdiff_t>(b));
     }
 
+    /**
+     * Check that a storage of nb_cells cells can be addressed by the index type
+     * of the intervals (only relevant for the compact 32-bit index).
+     */
+    template <class index_t>
+    void check_index_capacity(std::size_t nb_cells, std::size_t level)
+    {
+        if constexpr (sizeof(index_t) < sizeof(std::size_t))
+        {
+            if (nb_cells > static_cast<std::size_t>(std::numeric_limits<index_t>::max()))
+            {
+                throw std::overflow_error(
+                    fmt::format("The number of cells ({}) up to level {} is too large for the index type of the intervals.", nb_cells, level));
+            }
+        }
+    }
+
+    /**
+     * Morton (Z-order) code of non-negative coordinates: the nb_bits lowest
+     * bits of each coordinate are interleaved (nb_bits * dim <= 64).
+     */
+    template <std::size_t dim>
+    inline std::uint64_t morton_code(const std::array<std::uint64_t, dim>& coords, std::size_t nb_bits)
+    {
+        std::uint64_t code = 0;
+        for (std::size_t b = 0; b < nb_bits; ++b)
+        {
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                code |= ((coords[d] >> b) & std::uint64_t{1}) << (b * dim + d);
+            }
+        }
+        return code;
+    }
+
     template <class Field, class index_t>
     inline auto& field_value(Field& f, const typename Field::cell_t& cell, [[maybe_unused]] index_t field_i)
     {
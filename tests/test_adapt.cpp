@@ -4,6 +4,7 @@
 #include <samurai/mr/adapt.hpp>
 #include <samurai/mr/mesh.hpp>
 #include <samurai/samurai.hpp>
+#include <samurai/static_algorithm.hpp>
 
 namespace samurai
 {
@@ -40,4 +41,156 @@ namespace samurai
         adapt(1e-4, 2);
         ::samurai::finalize();
     }
+
+    TYPED_TEST(adapt_test, flat_cell_list)
+    {
+        ::samurai::initialize();
+
+        static constexpr std::size_t dim = TypeParam::value;
+        using config                     = MRConfig<dim>;
+
+        struct flat_config : config
+        {
+            using cl_type = FlatCellList<dim, typename config::interval_t, config::max_refinement_level>;
+        };
+
+        const Box<double, dim> box(xt::zeros<double>({dim}), xt::ones<double>({dim}));
+        auto mesh      = MRMesh<config>(box, 2, 5);
+        auto mesh_flat = MRMesh<flat_config>(box, 2, 5);
+        auto u         = make_scalar_field<double>("u", mesh);
+        auto u_flat    = make_scalar_field<double>("u", mesh_flat);
+
+        auto init = [](auto& field)
+        {
+            for_each_cell(field.mesh(),
+                          [&](const auto& cell)
+                          {
+                              field[cell] = std::exp(-50 * xt::sum(xt::square(cell.center() - 0.3))[0]);
+                          });
+        };
+        init(u);
+        init(u_flat);
+
+        auto adapt      = make_MRAdapt(u);
+        auto adapt_flat = make_MRAdapt(u_flat);
+        adapt(1e-3, 1);
+        adapt_flat(1e-3, 1);
+
+        using mesh_id_t = typename MRMesh<config>::mesh_id_t;
+        for (auto id : {mesh_id_t::cells, mesh_id_t::cells_and_ghosts, mesh_id_t::proj_cells, mesh_id_t::union_cells, mesh_id_t::all_cells})
+        {
+            EXPECT_EQ(u.mesh()[id], u_flat.mesh()[id]);
+        }
+        ::samurai::finalize();
+    }
+
+    TYPED_TEST(adapt_test, incremental_mesh_update)
+    {
+        ::samurai::initialize();
+
+        static constexpr std::size_t dim = TypeParam::value;
+        using config                     = MRConfig<dim>;
+        using mesh_t                     = MRMesh<config>;
+        using mesh_id_t                  = typename mesh_t::mesh_id_t;
+
+        const Box<double, dim> box(xt::zeros<double>({dim}), xt::ones<double>({dim}));
+        auto mesh = mesh_t(box, 2, 5);
+        auto u    = make_scalar_field<double>("u", mesh);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          u[cell] = std::exp(-50 * xt::sum(xt::square(cell.center() - 0.3))[0]);
+                      });
+
+        const mesh_t old_mesh = mesh;
+        auto adapt            = make_MRAdapt(u);
+        adapt(1e-3, 1);
+
+        auto check = [](const mesh_t& m1, const mesh_t& m2)
+        {
+            for (auto id :
+                 {mesh_id_t::cells, mesh_id_t::cells_and_ghosts, mesh_id_t::proj_cells, mesh_id_t::union_cells, mesh_id_t::all_cells})
+            {
+                EXPECT_EQ(m1[id], m2[id]);
+            }
+            EXPECT_EQ(m1.get_union(), m2.get_union());
+        };
+
+        // Built from the mesh before adaptation or from scratch
+        check(mesh_t(mesh[mesh_id_t::cells], old_mesh), mesh_t(mesh[mesh_id_t::cells], mesh.min_level(), mesh.max_level()));
+        // Unchanged cells
+        check(mesh_t(mesh[mesh_id_t::cells], mesh), mesh);
+
+        // One cell refined: the ghosts are only rebuilt around it
+        using cl_t   = typename mesh_t::cl_type;
+        cl_t cl;
+        bool refined = false;
+        for_each_cell(mesh[mesh_id_t::cells],
+                      [&](const auto& cell)
+                      {
+                          auto yz = xt::view(cell.indices, xt::range(1, _));
+                          if (!refined && cell.level < mesh.max_level())
+                          {
+                              refined = true;
+                              static_nested_loop<dim - 1, 0, 2>(
+                                  [&](auto stencil)
+                                  {
+                                      cl[cell.level + 1][2 * yz + stencil].add_interval({2 * cell.indices[0], 2 * cell.indices[0] + 2});
+                                  });
+                          }
+                          else
+                          {
+                              cl[cell.level][yz].add_point(cell.indices[0]);
+                          }
+                      });
+        EXPECT_TRUE(refined);
+        check(mesh_t(cl, mesh), mesh_t(cl, mesh.min_level(), mesh.max_level()));
+
+        ::samurai::finalize();
+    }
+
+    TYPED_TEST(adapt_test, hash_after_renumbering)
+    {
+        ::samurai::initialize();
+
+        static constexpr std::size_t dim = TypeParam::value;
+        using config                     = MRConfig<dim>;
+        using mesh_t                     = MRMesh<config>;
+        using mesh_id_t                  = typename mesh_t::mesh_id_t;
+
+        const Box<double, dim> box(xt::zeros<double>({dim}), xt::ones<double>({dim}));
+        auto mesh = mesh_t(box, 2, 5);
+        auto u    = make_scalar_field<double>("u", mesh);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          u[cell] = std::exp(-50 * xt::sum(xt::square(cell.center() - 0.3))[0]);
+                      });
+
+        const mesh_t old_mesh = mesh;
+        auto adapt            = make_MRAdapt(u);
+        adapt(1e-3, 1);
+
+        // the renumbering and the sub-meshes construction only set the indices:
+        // the hashes of the cells computed by the constructors stay valid
+        auto check = [](const mesh_t& m)
+        {
+            for (std::size_t level = 0; level <= config::max_refinement_level; ++level)
+            {
+                EXPECT_TRUE(m[mesh_id_t::cells][level].is_hash_valid());
+            }
+        };
+        check(mesh);
+
+        const mesh_t rebuilt(mesh[mesh_id_t::cells], old_mesh);
+        const mesh_t unchanged(mesh[mesh_id_t::cells], mesh);
+        check(rebuilt);
+        check(unchanged);
+
+        EXPECT_TRUE(rebuilt == unchanged);
+        check(rebuilt);
+        check(unchanged);
+
+        ::samurai::finalize();
+    }
 }
@@ -1,7 +1,12 @@
+#include <algorithm>
+#include <array>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <samurai/cell_array.hpp>
 #include <samurai/cell_list.hpp>
+#include <samurai/parallel.hpp>
 
 namespace samurai
 {
@@ -128,4 +133,145 @@ namespace samurai
         xt::xtensor_fixed<int, xt::xshape<2>> coords{1, 2};
         EXPECT_EQ(cell_array.get_cell(2, 2 * coords + 1), (cell_t(origin_point, scaling_factor, 2, 3, 5, 8)));
     }
+
+    TEST(cell_array, compact_interval)
+    {
+        constexpr size_t dim     = 2;
+        using compact_interval_t = default_config::compact_interval_t;
+
+        static_assert(sizeof(compact_interval_t) == 16);
+
+        CellList<dim> cell_list;
+        cell_list[1][{1}].add_interval({2, 5});
+        cell_list[2][{5}].add_interval({-2, 8});
+        cell_list[2][{5}].add_interval({9, 10});
+        cell_list[2][{6}].add_interval({10, 12});
+
+        CellList<dim, compact_interval_t> compact_cell_list;
+        compact_cell_list[1][{1}].add_interval({2, 5});
+        compact_cell_list[2][{5}].add_interval({-2, 8});
+        compact_cell_list[2][{5}].add_interval({9, 10});
+        compact_cell_list[2][{6}].add_interval({10, 12});
+
+        CellArray<dim> cell_array(cell_list);
+        CellArray<dim, compact_interval_t> compact_cell_array(compact_cell_list);
+
+        EXPECT_EQ(cell_array.nb_cells(), compact_cell_array.nb_cells());
+        for_each_cell(cell_array,
+                      [&](const auto& cell)
+                      {
+                          EXPECT_EQ(compact_cell_array.get_index(cell.level, cell.indices[0], cell.indices[1]), cell.index);
+                      });
+    }
+
+    TEST(cell_array, morton_index)
+    {
+        constexpr size_t dim = 2;
+
+        CellList<dim> cell_list;
+        cell_list[1][{1}].add_interval({2, 5});
+        cell_list[2][{5}].add_interval({-2, 8});
+        cell_list[2][{5}].add_interval({9, 10});
+        cell_list[2][{6}].add_interval({10, 12});
+        cell_list[2][{7}].add_interval({0, 4});
+        cell_list[3][{0}].add_interval({0, 4});
+        cell_list[3][{0}].add_interval({20, 24});
+        cell_list[3][{1}].add_interval({0, 4});
+
+        CellArray<dim> cell_array(cell_list);
+        CellArray<dim> morton_cell_array(cell_list);
+        morton_cell_array.update_index_morton();
+
+        EXPECT_EQ(cell_array.nb_cells(), morton_cell_array.nb_cells());
+
+        // each level keeps a contiguous range of indices
+        std::vector<bool> is_used(morton_cell_array.nb_cells(), false);
+        std::size_t first_index = 0;
+        for (std::size_t level = morton_cell_array.min_level(); level <= morton_cell_array.max_level(); ++level)
+        {
+            const auto& lca = morton_cell_array[level];
+            EXPECT_TRUE(lca.has_same_cells(cell_array[level]));
+            for_each_cell(lca,
+                          [&](const auto& cell)
+                          {
+                              EXPECT_GE(cell.index, first_index);
+                              EXPECT_LT(cell.index, first_index + lca.nb_cells());
+                              EXPECT_FALSE(is_used[cell.index]);
+                              is_used[cell.index] = true;
+                              EXPECT_EQ(morton_cell_array.get_index(cell.level, cell.indices[0], cell.indices[1]), cell.index);
+                          });
+            first_index += lca.nb_cells();
+        }
+        EXPECT_TRUE(std::all_of(is_used.cbegin(), is_used.cend(),
+                                [](bool used)
+                                {
+                                    return used;
+                                }));
+
+        // the intervals of a tile keep the lexicographic order
+        static_assert(LevelCellArray<dim>::morton_tile_bits == 4);
+        for (std::size_t k = 0; k < cell_array[2][0].size(); ++k)
+        {
+            EXPECT_EQ(morton_cell_array[2][0][k].index, cell_array[2][0][k].index);
+        }
+        // the tile of the cells 20 to 23 of the row 0 follows the one of the rows 0 and 1
+        EXPECT_EQ(morton_cell_array.get_index(3, 0, 0), 20);
+        EXPECT_EQ(morton_cell_array.get_index(3, 0, 1), 24);
+        EXPECT_EQ(morton_cell_array.get_index(3, 20, 0), 28);
+    }
+
+    TEST(cell_array, hash)
+    {
+        constexpr size_t dim = 2;
+
+        CellList<dim> cell_list;
+        cell_list[1][{1}].add_interval({2, 5});
+        cell_list[2][{5}].add_interval({-2, 8});
+        cell_list[2][{5}].add_interval({9, 10});
+        cell_list[2][{6}].add_interval({10, 12});
+
+        CellArray<dim> cell_array_1(cell_list);
+        CellArray<dim> cell_array_2(cell_list);
+        EXPECT_EQ(cell_array_1.hash(), cell_array_2.hash());
+        EXPECT_EQ(cell_array_1, cell_array_2);
+
+        // the indices of the x-intervals are not taken into account
+        cell_array_2.update_index_morton();
+        EXPECT_EQ(cell_array_1.hash(), cell_array_2.hash());
+
+        // the hash is updated by the modifications of the intervals
+        LevelCellArray<dim> lca(cell_array_1[2]);
+        lca.add_interval_back({0, 2}, {7});
+        EXPECT_NE(lca.hash(), cell_array_1[2].hash());
+        EXPECT_FALSE(lca == cell_array_1[2]);
+
+        lca[0].back().end = 4;
+        LevelCellList<dim> lcl(2);
+        lcl[{5}].add_interval({-2, 8});
+        lcl[{5}].add_interval({9, 10});
+        lcl[{6}].add_interval({10, 12});
+        lcl[{7}].add_interval({0, 4});
+        EXPECT_EQ(lca.hash(), LevelCellArray<dim>(lcl).hash());
+
+        // the constructors compute the hash, the concurrent reads after a modification compute it once
+        EXPECT_TRUE(LevelCellArray<dim>(lcl).is_hash_valid());
+        lca.add_interval_back({1, 3}, {9});
+        EXPECT_FALSE(lca.is_hash_valid());
+
+        const auto& const_lca = lca;
+        std::vector<std::size_t> hashes(64);
+        std::vector<std::array<int, dim>> min_indices(hashes.size());
+        parallel::for_each_index(hashes.size(),
+                                 [&](std::size_t i)
+                                 {
+                                     hashes[i]      = const_lca.hash();
+                                     min_indices[i] = const_lca.min_indices();
+                                 });
+        EXPECT_TRUE(lca.is_hash_valid());
+        for (std::size_t i = 0; i < hashes.size(); ++i)
+        {
+            EXPECT_EQ(hashes[i], lca.hash());
+            EXPECT_EQ(min_indices[i], (std::array<int, dim>{-2, 5}));
+        }
+    }
 }
@@ -0,0 +1,50 @@
+#include <algorithm>
+#include <cmath>
+#include <type_traits>
+
+#include <gtest/gtest.h>
+
+#include <samurai/algorithm/update.hpp>
+#include <samurai/bc.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/schemes/fv.hpp>
+
+namespace samurai
+{
+    template <class value_t, class Mesh>
+    auto apply_diffusion(Mesh& mesh)
+    {
+        auto u = make_scalar_field<value_t>("u", mesh);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          const double x = cell.center(0);
+                          u[cell]        = static_cast<value_t>(1. + x * x);
+                      });
+        make_bc<Dirichlet<1>>(u, 1.);
+        update_ghost_mr(u);
+
+        auto diff = make_diffusion_order2<decltype(u)>();
+        return diff(u);
+    }
+
+    TEST(explicit_scheme, float_field)
+    {
+        Box<double, 1> box{{0}, {1}};
+        using Config = MRConfig<1>;
+        auto mesh    = MRMesh<Config>(box, 4, 4);
+
+        auto diff_double = apply_diffusion<double>(mesh);
+        auto diff_float  = apply_diffusion<float>(mesh);
+        static_assert(std::is_same_v<typename decltype(diff_float)::value_type, float>);
+
+        // the contributions are computed in double and stored in float
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          const double expected = diff_double[cell];
+                          EXPECT_NEAR(diff_float[cell], expected, 1e-3 * std::max(1., std::abs(expected)));
+                      });
+    }
+}
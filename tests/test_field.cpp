@@ -1,4 +1,9 @@
 #include <algorithm>
+#include <array>
+#include <cstdint>
+#include <tuple>
+#include <type_traits>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -140,4 +145,255 @@ namespace samurai
         u.name() = "new_name";
         EXPECT_EQ(u.name(), "new_name");
     }
+
+    TEST(field, morton_ordering)
+    {
+        // the ordering of the next tests is restored even if an assertion fails
+        struct morton_ordering_guard
+        {
+            bool previous = args::morton_ordering;
+
+            morton_ordering_guard()
+            {
+                args::morton_ordering = true;
+            }
+
+            ~morton_ordering_guard()
+            {
+                args::morton_ordering = previous;
+            }
+        };
+
+        const morton_ordering_guard guard;
+
+        Box<double, 2> box{{0, 0}, {1, 1}};
+        using Config    = MRConfig<2>;
+        using mesh_id_t = typename MRMesh<Config>::mesh_id_t;
+        auto mesh       = MRMesh<Config>(box, 2, 5);
+
+        // the storage holds all the cells and ghosts, each at its own index
+        auto u = make_scalar_field<double>("u", mesh, 0.);
+        std::vector<bool> is_used(u.array().size(), false);
+        for_each_cell(mesh[mesh_id_t::reference],
+                      [&](const auto& cell)
+                      {
+                          const auto index = static_cast<std::size_t>(cell.index);
+                          ASSERT_LT(index, is_used.size());
+                          EXPECT_FALSE(is_used[index]);
+                          is_used[index] = true;
+                          u[cell]        = 1.;
+                      });
+        EXPECT_EQ(static_cast<std::size_t>(std::count(is_used.begin(), is_used.end(), true)),
+                  mesh[mesh_id_t::reference].nb_cells());
+
+        // in the storage, the x-intervals of a level are ordered by tiles along a Morton curve, then lexicographically
+        constexpr std::size_t tile_bits = LevelCellArray<2>::morton_tile_bits;
+        for_each_level(mesh[mesh_id_t::reference],
+                       [&](std::size_t level)
+                       {
+                           const auto& lca       = mesh[mesh_id_t::reference][level];
+                           const auto min_corner = lca.min_indices();
+                           // (first index, tile, y, x)
+                           std::vector<std::tuple<std::int64_t, std::uint64_t, int, int>> intervals;
+                           for_each_interval(lca,
+                                             [&](auto, const auto& interval, const auto& index)
+                                             {
+                                                 const std::array<std::uint64_t, 2> tile{
+                                                     static_cast<std::uint64_t>(interval.start - min_corner[0]) >> tile_bits,
+                                                     static_cast<std::uint64_t>(index[0] - min_corner[1]) >> tile_bits};
+                                                 intervals.emplace_back(interval.index + interval.start,
+                                                                        morton_code(tile, 32),
+                                                                        index[0],
+                                                                        interval.start);
+                                             });
+                           std::sort(intervals.begin(), intervals.end());
+                           EXPECT_TRUE(std::is_sorted(intervals.begin(),
+                                                      intervals.end(),
+                                                      [](const auto& a, const auto& b)
+                                                      {
+                                                          return std::tie(std::get<1>(a), std::get<2>(a), std::get<3>(a))
+                                                               < std::tie(std::get<1>(b), std::get<2>(b), std::get<3>(b));
+                                                      }));
+                       });
+    }
+
+    TEST(field, flat_expression)
+    {
+        Box<double, 2> box{{0, 0}, {1, 1}};
+        using Config    = MRConfig<2>;
+        using mesh_id_t = typename MRMesh<Config>::mesh_id_t;
+        auto mesh       = MRMesh<Config>(box, 2, 4);
+
+        auto u = make_scalar_field<double>("u", mesh, 7.);
+        auto f = make_scalar_field<double>("f", mesh, 2.);
+        auto v = make_vector_field<double, 3>("v", mesh, 7.);
+        auto g = make_vector_field<double, 3>("g", mesh, 2.);
+
+        u = u + 0.5 * f;
+        v = v + 0.5 * g;
+
+        for_each_cell(mesh[mesh_id_t::cells],
+                      [&](const auto& cell)
+                      {
+                          EXPECT_EQ(u[cell], 8.);
+                      });
+
+        // only the cells are assigned, not the ghosts
+        auto count = [](const auto& array, double value)
+        {
+            return static_cast<std::size_t>(std::count(array.data(), array.data() + array.size(), value));
+        };
+        const auto nb_cells  = mesh.nb_cells(mesh_id_t::cells);
+        const auto nb_ghosts = mesh.nb_cells(mesh_id_t::reference) - nb_cells;
+        EXPECT_EQ(count(u.array(), 7.), nb_ghosts);
+        EXPECT_EQ(count(v.array(), 8.), 3 * nb_cells);
+        EXPECT_EQ(count(v.array(), 7.), 3 * nb_ghosts);
+    }
+
+#ifndef SAMURAI_FIELD_CONTAINER_EIGEN3
+    TEST(field, aligned_storage)
+    {
+        Box<double, 2> box{{0, 0}, {1, 1}};
+        using Config = MRConfig<2>;
+        auto mesh    = MRMesh<Config>(box, 2, 4);
+
+        auto u = make_scalar_field<double>("u", mesh);
+        auto v = make_vector_field<float, 3>("v", mesh);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(u.array().data()) % field_alignment, 0);
+        EXPECT_EQ(reinterpret_cast<std::uintptr_t>(v.array().data()) % field_alignment, 0);
+    }
+
+    TEST(field, storage_fill)
+    {
+        auto check = [](auto storage)
+        {
+            storage.data().fill(0);
+            storage.fill(2, 5, 1);
+            for (std::size_t i = 0; i < 8; ++i)
+            {
+                const auto expected = (i >= 2 && i < 5) ? 1 : 0;
+                EXPECT_TRUE(xt::all(xt::equal(view(storage, i), expected)));
+            }
+        };
+        check(field_data_storage_t<double, 1>(8));
+        check(field_data_storage_t<double, 3, false, false>(8));
+        check(field_data_storage_t<double, 3, true, false>(8));
+    }
+
+    TEST(field, accumulation_type)
+    {
+        static_assert(std::is_same_v<accumulation_t<float>, double>);
+        static_assert(std::is_same_v<accumulation_t<double>, double>);
+
+        Box<double, 1> box{{0}, {1}};
+        using Config     = UniformConfig<1>;
+        using interval_t = typename UniformMesh<Config>::interval_t;
+        auto mesh        = UniformMesh<Config>(box, 3);
+
+        // a float field is loaded as double by the operators
+        auto u      = make_scalar_field<float>("u", mesh, 1.f);
+        auto values = eval(accumulation_cast(u(3, interval_t{0, 8})));
+        static_assert(std::is_same_v<typename decltype(values)::value_type, double>);
+        EXPECT_TRUE(xt::all(xt::equal(values, 1.)));
+    }
+
+    TEST(field, memory_pool)
+    {
+        using Placement = MemoryPool::Placement;
+        using storage_t = field_data_storage_t<double, 1>;
+
+        auto& pool = MemoryPool::instance();
+        pool.release();
+        pool.reset_statistics();
+
+        EXPECT_EQ(MemoryPool::block_size(80000), 81920);
+        EXPECT_EQ(MemoryPool::block_size(72000), 81920);
+        EXPECT_EQ(MemoryPool::block_size(100), 100);
+
+        // with several threads, an array is only reused with the same placement and size
+        const bool placed = MemoryPool::placed_by_first_touch();
+        auto expect_hit   = [&](bool hit, auto&& allocate)
+        {
+            const auto before = pool.statistics();
+            allocate();
+            const auto after = pool.statistics();
+            EXPECT_EQ(after.hits, before.hits + (hit ? 1 : 0));
+            EXPECT_EQ(after.misses, before.misses + (hit ? 0 : 1));
+        };
+
+        expect_hit(false,
+                   []
+                   {
+                       storage_t storage(10000);
+                   });
+        EXPECT_EQ(pool.statistics().cached_blocks, 1);
+        // about the same size: the array is reused
+        expect_hit(true,
+                   []
+                   {
+                       storage_t storage(9000);
+                   });
+        expect_hit(!placed,
+                   []
+                   {
+                       const Placement placement(1);
+                       storage_t storage(10000);
+                       EXPECT_FALSE(placement.reused());
+                   });
+        expect_hit(true,
+                   [&]
+                   {
+                       const Placement placement(1);
+                       storage_t storage(10000);
+                       EXPECT_EQ(placement.reused(), placed);
+                   });
+        expect_hit(!placed,
+                   []
+                   {
+                       const Placement placement(2);
+                       storage_t storage(10000);
+                   });
+        expect_hit(!placed,
+                   []
+                   {
+                       const Placement placement(1);
+                       storage_t storage(9000);
+                   });
+
+        // the temporaries of a mesh reuse the arrays of its fields, not the ones of another mesh
+        Box<double, 1> box{{0}, {1}};
+        using Config = MRConfig<1>;
+        auto mesh_a  = MRMesh<Config>(box, 12, 12);
+        auto mesh_b  = MRMesh<Config>(box, 12, 12);
+        {
+            auto u = make_scalar_field<double>("u", mesh_a);
+        }
+        expect_hit(true,
+                   [&]
+                   {
+                       auto v = make_scalar_field<double>("v", mesh_a);
+                   });
+        expect_hit(!placed,
+                   [&]
+                   {
+                       auto w = make_scalar_field<double>("w", mesh_b);
+                   });
+
+        // the cache is capped relatively to the largest array, the oldest arrays being freed
+        const auto max_cached_arrays = pool.max_cached_arrays();
+        pool.release();
+        pool.max_cached_arrays(1);
+        {
+            storage_t first(10000);
+            storage_t second(20000);
+        }
+        EXPECT_EQ(pool.max_cached_bytes(), MemoryPool::block_size(160000));
+        EXPECT_EQ(pool.statistics().cached_blocks, 1);
+        EXPECT_EQ(pool.statistics().cached_bytes, MemoryPool::block_size(80000));
+        pool.max_cached_arrays(max_cached_arrays);
+
+        pool.release();
+        EXPECT_EQ(pool.statistics().cached_bytes, 0);
+    }
+#endif
 }
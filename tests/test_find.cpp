@@ -41,4 +41,55 @@ namespace samurai
         EXPECT_TRUE(static_cast<std::size_t>(cell.index) < mesh.nb_cells());                      // cell index makes sense
         EXPECT_TRUE(xt::all(cell.corner() <= coords && coords <= (cell.corner() + cell.length))); // coords in cell
     }
+
+    TEST(find, row_cursor)
+    {
+        static constexpr std::size_t dim = 2;
+        using Config                     = samurai::MRConfig<dim>;
+        using Box                        = samurai::Box<double, dim>;
+        using Mesh                       = samurai::MRMesh<Config>;
+        using mesh_id_t                  = typename Mesh::mesh_id_t;
+
+        Box box({-1., -1.}, {1., 1.});
+        Mesh mesh{box, 2, 6};
+
+        auto u = samurai::make_scalar_field<double>("u",
+                                                    mesh,
+                                                    [](const auto& coords)
+                                                    {
+                                                        const auto& x = coords(0);
+                                                        const auto& y = coords(1);
+                                                        return (x >= -0.8 && x <= -0.3 && y >= 0.3 && y <= 0.8) ? 1. : 0.;
+                                                    });
+
+        auto MRadaptation = samurai::make_MRAdapt(u);
+        MRadaptation(1e-3, 1);
+
+        for (std::size_t level = mesh.min_level(); level <= mesh.max_level(); ++level)
+        {
+            const auto& lca = mesh[mesh_id_t::cells_and_ghosts][level];
+            auto cursor     = samurai::make_row_cursor(lca);
+
+            samurai::for_each_interval(lca,
+                                       [&](std::size_t, const auto& interval, const auto& index)
+                                       {
+                                           // one cell before and after the interval to check the misses
+                                           for (auto i = interval.start - 1; i <= interval.end; ++i)
+                                           {
+                                               xt::xtensor_fixed<int, xt::xshape<dim>> coord{i, index[0]};
+                                               EXPECT_EQ(cursor.find(i, index), samurai::find(lca, coord));
+                                           }
+                                       });
+
+            // going backward along the rows
+            samurai::for_each_interval(lca,
+                                       [&](std::size_t, const auto& interval, const auto& index)
+                                       {
+                                           for (auto i = interval.end - 1; i >= interval.start; --i)
+                                           {
+                                               EXPECT_EQ(cursor.get_index(i, index), lca.get_index(i, index[0]));
+                                           }
+                                       });
+        }
+    }
 }
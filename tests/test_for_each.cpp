@@ -1,3 +1,6 @@
+#include <algorithm>
+#include <vector>
+
 #include <gtest/gtest.h>
 #include <samurai/amr/mesh.hpp>
 
@@ -83,4 +86,77 @@ namespace samurai
                       });
         EXPECT_EQ(nb_cells, 2);
     }
+
+    TEST(set, parallel_for_each_cell)
+    {
+        constexpr std::size_t dim = 2;
+        using lca_t               = LevelCellArray<dim>;
+
+        LevelCellList<dim> lcl{6};
+        for (int y = 0; y < 64; y += 1 + y % 3)
+        {
+            lcl[{y}].add_interval({-y % 5, 3 + y % 7});
+            lcl[{y}].add_interval({8 + y % 3, 20 + y});
+        }
+        const lca_t lca(lcl);
+
+        // the iterator placed by bisection is the one reached by increments
+        std::size_t position = 0;
+        for (auto it = lca.cbegin(); it != lca.cend(); ++it, ++position)
+        {
+            auto it_at = lca.citerator_at(position);
+            EXPECT_EQ(*it_at, *it);
+            EXPECT_EQ(it_at.index(), it.index());
+        }
+        EXPECT_TRUE(lca.citerator_at(position) == lca.cend());
+
+        std::vector<int> visits(lca.nb_cells(), 0);
+        for_each_cell<Run::Parallel>(lca,
+                                     [&](const auto& cell)
+                                     {
+                                         EXPECT_EQ(lca.get_index(cell.indices), cell.index);
+                                         ++visits[static_cast<std::size_t>(cell.index)];
+                                     });
+        EXPECT_TRUE(std::all_of(visits.cbegin(), visits.cend(),
+                                [](int v)
+                                {
+                                    return v == 1;
+                                }));
+    }
+
+    TEST(set, for_each_cell_batch)
+    {
+        constexpr std::size_t dim = 2;
+        using Config              = amr::Config<dim>;
+        using Mesh                = amr::Mesh<Config>;
+
+        const Box<double, dim> box({-1., -1.}, {1., 1.});
+        const Mesh mesh(box, 3, 2, 4);
+
+        using index_t  = typename Mesh::interval_t::index_t;
+        using coords_t = xt::xtensor_fixed<double, xt::xshape<dim>>;
+
+        std::vector<std::pair<index_t, coords_t>> expected;
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          expected.emplace_back(cell.index, cell.center());
+                      });
+
+        std::size_t k = 0;
+        for_each_cell_batch(mesh,
+                            [&](const auto& batch)
+                            {
+                                for (std::size_t i = 0; i < batch.size(); ++i, ++k)
+                                {
+                                    ASSERT_LT(k, expected.size());
+                                    EXPECT_EQ(batch.indices[i], expected[k].first);
+                                    for (std::size_t d = 0; d < dim; ++d)
+                                    {
+                                        EXPECT_DOUBLE_EQ(batch.centers[d][i], expected[k].second[d]);
+                                    }
+                                }
+                            });
+        EXPECT_EQ(k, expected.size());
+    }
 }
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 #include <xtensor/xarray.hpp>
 
+#include <samurai/level_cell_array.hpp>
 #include <samurai/level_cell_list.hpp>
 
 namespace samurai
@@ -11,4 +12,56 @@ namespace samurai
         LevelCellList<dim> lcl;
         lcl[{0}].add_interval({-3, 3});
     }
+
+    TEST(level_cell_list, flat_2d)
+    {
+        constexpr size_t dim = 2;
+        LevelCellList<dim> lcl{3};
+        FlatLevelCellList<dim> flat{3};
+
+        // Unordered, overlapping and adjacent intervals on sparse rows
+        for (int k = 0; k < 200; ++k)
+        {
+            int y     = (k * 7) % 13 - 4;
+            int start = (k * 11) % 23 - 8;
+            int end   = start + 1 + k % 5;
+            lcl[{y}].add_interval({start, end});
+            flat[{y}].add_interval({start, end});
+        }
+        flat[{20}].add_point(-1);
+        flat[{20}].add_point(0);
+        lcl[{20}].add_point(-1);
+        lcl[{20}].add_point(0);
+
+        LevelCellArray<dim> lca{lcl};
+        LevelCellArray<dim> lca_flat{flat};
+        EXPECT_EQ(lca, lca_flat);
+        EXPECT_EQ(lca.nb_cells(), lca_flat.nb_cells());
+    }
+
+    TEST(level_cell_list, flat_3d)
+    {
+        constexpr size_t dim = 3;
+        LevelCellList<dim> lcl{2};
+        FlatLevelCellList<dim> flat{2};
+
+        for (int k = 0; k < 500; ++k)
+        {
+            int y     = (k * 5) % 9 - 2;
+            int z     = (k * 3) % 7;
+            int start = (k * 13) % 31 - 10;
+            int end   = start + 1 + k % 3;
+            lcl[{y, z}].add_interval({start, end});
+            flat[{y, z}].add_interval({start, end});
+        }
+
+        LevelCellArray<dim> lca{lcl};
+        LevelCellArray<dim> lca_flat{flat};
+        EXPECT_EQ(lca, lca_flat);
+
+        // Adding after a conversion sorts and merges again
+        lcl[{-5, 1}].add_interval({0, 4});
+        flat[{-5, 1}].add_interval({0, 4});
+        EXPECT_EQ(LevelCellArray<dim>(lcl), LevelCellArray<dim>(flat));
+    }
 }
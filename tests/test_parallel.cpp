@@ -0,0 +1,83 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <samurai/parallel.hpp>
+
+namespace samurai
+{
+    TEST(parallel, for_each_index)
+    {
+        std::vector<int> hits(10000, 0);
+        std::vector<std::size_t> threads(hits.size());
+
+        parallel::for_each_index(
+            hits.size(),
+            [&](std::size_t i)
+            {
+                ++hits[i];
+                threads[i] = parallel::thread_num();
+            },
+            16);
+
+        for (std::size_t i = 0; i < hits.size(); ++i)
+        {
+            EXPECT_EQ(hits[i], 1);
+            EXPECT_LT(threads[i], parallel::max_threads());
+        }
+        EXPECT_FALSE(parallel::in_parallel());
+    }
+
+    TEST(parallel, nested_for_each_index)
+    {
+        std::vector<int> hits(64 * 64, 0);
+
+        parallel::for_each_index(64,
+                                 [&](std::size_t i)
+                                 {
+                                     const std::size_t thread = parallel::thread_num();
+                                     parallel::for_each_index(64,
+                                                              [&](std::size_t j)
+                                                              {
+                                                                  // a nested loop stays on the calling thread
+                                                                  EXPECT_EQ(parallel::thread_num(), thread);
+                                                                  ++hits[i * 64 + j];
+                                                              });
+                                 });
+
+        for (auto h : hits)
+        {
+            EXPECT_EQ(h, 1);
+        }
+    }
+
+    TEST(parallel, atomic_add)
+    {
+        double sum = 0;
+        parallel::for_each_index(1000,
+                                 [&](std::size_t)
+                                 {
+                                     parallel::atomic_add(sum, 0.5);
+                                 });
+        EXPECT_EQ(sum, 500.);
+    }
+
+    TEST(parallel, for_each_thread)
+    {
+        std::vector<int> calls(parallel::max_threads(), 0);
+        std::size_t team_size = 0;
+
+        parallel::for_each_thread(
+            [&](std::size_t thread, std::size_t nb_threads)
+            {
+                EXPECT_LT(thread, nb_threads);
+                ++calls[thread];
+                parallel::atomic_add(team_size, std::size_t{1});
+            });
+
+        for (std::size_t t = 0; t < team_size; ++t)
+        {
+            EXPECT_EQ(calls[t], 1);
+        }
+    }
+}
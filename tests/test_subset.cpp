@@ -1,6 +1,8 @@
+#include <algorithm>
 #include <cstddef>
 #include <filesystem>
 #include <span>
+#include <string>
 #include <tuple>
 #include <xtensor/xfixed.hpp>
 
@@ -10,8 +12,10 @@
 #include <samurai/cell_list.hpp>
 #include <samurai/interval.hpp>
 #include <samurai/level_cell_array.hpp>
+#include <samurai/level_cell_array_view.hpp>
 #include <samurai/mr/mesh.hpp>
 #include <samurai/subset/node.hpp>
+#include <samurai/subset/plan.hpp>
 #include <xtensor/xtensor_forward.hpp>
 
 namespace samurai
@@ -1319,4 +1323,556 @@ namespace samurai
         EXPECT_TRUE(intersection(lca, translate(lca, translation)).empty());
     }
 
+    TEST(subset, parallel_construction)
+    {
+        constexpr std::size_t dim = 3;
+
+        // Rows of uneven sizes, with enough positions along z to be split in chunks
+        LevelCellList<dim> lcl{8};
+        FlatLevelCellList<dim> flat{8};
+        for (int z = 0; z < 256; ++z)
+        {
+            for (int y = 0; y < 64; ++y)
+            {
+                const int r2 = (z - 128) * (z - 128) / 16 + (y - 32) * (y - 32);
+                if (r2 < 1024)
+                {
+                    lcl[{y, z}].add_interval({-30 + r2 % 7, 2 + r2 % 11});
+                    lcl[{y, z}].add_interval({5 + r2 % 5, 40});
+                    flat[{y, z}].add_interval({5 + r2 % 5, 40});
+                    flat[{y, z}].add_interval({-30 + r2 % 7, 2 + r2 % 11});
+                }
+            }
+        }
+        const LevelCellArray<dim> lca(lcl, Run::Sequential);
+        xt::xtensor_fixed<int, xt::xshape<dim>> stencil{1, -2, 3};
+
+        auto check = [](auto set)
+        {
+            EXPECT_EQ(LevelCellArray<dim>(set, Run::Sequential), LevelCellArray<dim>(set, Run::Parallel));
+        };
+        check(union_(lca, translate(lca, stencil)));
+        check(difference(lca, translate(lca, stencil)));
+        check(intersection(lca, contraction(lca, 1)));
+        check(union_(lca, translate(lca, stencil)).on(7));
+        check(translate(lca, stencil).on(9));
+
+        EXPECT_EQ(lca, LevelCellArray<dim>(lcl, Run::Parallel));
+        EXPECT_EQ(lca, LevelCellArray<dim>(flat, Run::Parallel));
+    }
+
+    TEST(subset, level_cell_array_view)
+    {
+        constexpr std::size_t dim = 2;
+        using lca_t               = LevelCellArray<dim>;
+        using view_t              = LevelCellArrayView<dim>;
+        using interval_t          = typename lca_t::interval_t;
+
+        LevelCellList<dim> lcl{6};
+        for (int y = 0; y < 64; ++y)
+        {
+            const int r2 = (y - 32) * (y - 32);
+            if (r2 < 900)
+            {
+                lcl[{y}].add_interval({-30 + r2 % 7, 2 + r2 % 11});
+                lcl[{y}].add_interval({5 + r2 % 5, 40});
+            }
+        }
+        const lca_t lca(lcl);
+        xt::xtensor_fixed<int, xt::xshape<dim>> stencil{1, -2};
+
+        // buffers which are not owned by a LevelCellArray, as a received MPI message
+        std::vector<interval_t> x_intervals(lca[0].begin(), lca[0].end());
+        std::vector<interval_t> y_intervals(lca[1].begin(), lca[1].end());
+        std::vector<std::size_t> offsets(lca.offsets(1).begin(), lca.offsets(1).end());
+        const view_t view(lca.level(), {x_intervals, y_intervals}, {offsets}, lca.origin_point(), lca.scaling_factor());
+
+        EXPECT_EQ(view.nb_cells(), lca.nb_cells());
+        EXPECT_EQ(view.shape(), lca.shape());
+
+        EXPECT_EQ(lca_t(union_(lca, translate(lca, stencil))), lca_t(union_(view, translate(view, stencil))));
+        EXPECT_EQ(lca_t(difference(lca, translate(lca, stencil))), lca_t(difference(view, translate(lca, stencil))));
+        EXPECT_EQ(lca_t(intersection(lca, contraction(lca, 1)).on(4)), lca_t(intersection(view, contraction(view, 1)).on(4)));
+        EXPECT_EQ(lca_t(translate(lca, stencil).on(8)), lca_t(translate(make_level_cell_array_view(lca), stencil).on(8)));
+
+        std::size_t nb_cells = 0;
+        for_each_cell(view,
+                      [&](const auto& cell)
+                      {
+                          EXPECT_EQ(lca.get_index(cell.indices[0], cell.indices[1]), cell.index);
+                          ++nb_cells;
+                      });
+        EXPECT_EQ(nb_cells, lca.nb_cells());
+    }
+
+    TEST(subset, plan)
+    {
+        constexpr std::size_t dim = 2;
+        using lca_t               = LevelCellArray<dim>;
+        using interval_t          = typename lca_t::interval_t;
+        using plan_t              = SubsetPlan<dim, interval_t>;
+
+        LevelCellList<dim> lcl{6};
+        for (int y = 0; y < 64; ++y)
+        {
+            lcl[{y}].add_interval({-y % 7, 20 + y % 11});
+        }
+        const lca_t lca(lcl);
+        xt::xtensor_fixed<int, xt::xshape<dim>> stencil{1, -2};
+
+        std::vector<std::pair<interval_t, int>> expected;
+        difference(lca, translate(lca, stencil))
+            .on(5)(
+                [&](const auto& i, const auto& index)
+                {
+                    expected.emplace_back(i, index[0]);
+                });
+
+        const plan_t plan(difference(lca, translate(lca, stencil)).on(5));
+        EXPECT_EQ(plan.level(), 5U);
+        EXPECT_EQ(plan.nb_intervals(), expected.size());
+
+        std::size_t ie = 0;
+        plan.apply_op(
+            [&](std::size_t level, const auto& i, const auto& index)
+            {
+                EXPECT_EQ(level, 5U);
+                EXPECT_EQ(expected[ie++], std::make_pair(i, static_cast<int>(index[0])));
+            });
+        EXPECT_EQ(ie, expected.size());
+
+        // a plan is only evaluated once per generation
+        SubsetPlanCache<dim, interval_t> cache;
+        const auto& plan_1 = cache.get({"difference", 5}, 1, difference(lca, translate(lca, stencil)).on(5));
+        const auto& plan_2 = cache.get({"difference", 5}, 1, intersection(lca, lca).on(5));
+        EXPECT_EQ(&plan_1, &plan_2);
+        EXPECT_EQ(plan_2.nb_intervals(), expected.size());
+
+        const auto& plan_3 = cache.get({"difference", 5}, 2, intersection(lca, lca).on(5));
+        EXPECT_EQ(plan_3.nb_intervals(), plan_t(intersection(lca, lca).on(5)).nb_intervals());
+
+        // the names are copied by the cache: a key may refer to a temporary
+        const auto& plan_4 = cache.get({std::string("temporary_") + "name", 5}, 2, intersection(lca, lca).on(5));
+        const auto& plan_5 = cache.get({"temporary_name", 5}, 2, difference(lca, lca).on(5));
+        EXPECT_EQ(&plan_4, &plan_5);
+
+        // the generation of a mesh changes when it is rebuilt
+        using Config = MRConfig<dim>;
+        const Box<double, dim> box({0, 0}, {1, 1});
+        MRMesh<Config> mesh{box, 2, 4};
+        MRMesh<Config> other_mesh{box, 2, 4};
+        EXPECT_NE(mesh.generation(), other_mesh.generation());
+
+        // also when it is built from a mesh with the same cells
+        using mesh_id_t = MRMesh<Config>::mesh_id_t;
+        const MRMesh<Config> same_cells_mesh(mesh[mesh_id_t::cells], mesh);
+        EXPECT_NE(same_cells_mesh.generation(), 0U);
+        EXPECT_NE(same_cells_mesh.generation(), mesh.generation());
+
+        // the plans are evaluated again when the cells are modified through the mutable accessors
+        const std::size_t level = mesh[mesh_id_t::cells].max_level();
+        EXPECT_FALSE(mesh.subset_plan("cells", level, self(mesh[mesh_id_t::cells][level])).empty());
+        mesh[mesh_id_t::cells][level].clear();
+        EXPECT_TRUE(mesh.subset_plan("cells", level, self(mesh[mesh_id_t::cells][level])).empty());
+    }
+
+    TEST(subset, parallel_apply)
+    {
+        constexpr std::size_t dim = 2;
+        using lca_t               = LevelCellArray<dim>;
+
+        LevelCellList<dim> lcl{6};
+        for (int y = 0; y < 64; ++y)
+        {
+            lcl[{y}].add_interval({2 + y % 7, 20 + y % 11});
+            lcl[{y}].add_interval({30 - y % 5, 50});
+        }
+        const lca_t lca(lcl);
+        xt::xtensor_fixed<int, xt::xshape<dim>> stencil{1, -2};
+
+        // each cell is written by one call only: the parallel traversal is race-free
+        constexpr int shift = 8;
+        constexpr int size  = 80;
+        auto mark           = [](std::vector<int>& cells)
+        {
+            return [&cells](std::size_t, const auto& i, const auto& index)
+            {
+                for (auto x = i.start; x < i.end; ++x)
+                {
+                    cells[static_cast<std::size_t>((index[0] + shift) * size + x + shift)] += 1;
+                }
+            };
+        };
+
+        std::vector<int> expected(size * size, 0);
+        std::vector<int> cells(size * size, 0);
+        std::vector<int> plan_cells(size * size, 0);
+
+        difference(lca, translate(lca, stencil)).on(5).apply_op(mark(expected));
+        difference(lca, translate(lca, stencil)).on(5).apply_op<Run::Parallel>(mark(cells));
+        SubsetPlan<dim, typename lca_t::interval_t>(difference(lca, translate(lca, stencil)).on(5)).apply_op<Run::Parallel>(mark(plan_cells));
+
+        EXPECT_EQ(expected, cells);
+        EXPECT_EQ(expected, plan_cells);
+        EXPECT_NE(std::count(expected.cbegin(), expected.cend(), 1), 0);
+    }
+
+    TEST(subset, binary_merge)
+    {
+        constexpr std::size_t dim = 2;
+        using lca_t               = LevelCellArray<dim>;
+        using interval_t          = typename lca_t::interval_t;
+
+        LevelCellList<dim> lcl_1{5};
+        LevelCellList<dim> lcl_2{6};
+        for (int y = 0; y < 32; ++y)
+        {
+            lcl_1[{y}].add_interval({-y % 5, 3 + y % 7});
+            lcl_1[{y}].add_interval({8 + y % 3, 20});
+            lcl_2[{2 * y}].add_interval({2 * (y % 4), 2 * (y % 4) + 1});
+            lcl_2[{2 * y}].add_interval({10 + y % 9, 16 + y % 13});
+            lcl_2[{2 * y}].add_interval({17 + y % 13, 45});
+        }
+        const lca_t lca_1(lcl_1);
+        const lca_t lca_2(lcl_2);
+        xt::xtensor_fixed<int, xt::xshape<dim>> stencil{1, 1};
+
+        auto intervals = [](auto&& set)
+        {
+            std::vector<std::pair<interval_t, int>> output;
+            set(
+                [&](const auto& i, const auto& index)
+                {
+                    output.emplace_back(interval_t{i.start, i.end}, index[0]);
+                });
+            return output;
+        };
+
+        // with two operands the intervals of a row are merged in one pass,
+        // the third operand takes the generic traversal
+        for (std::size_t level = 3; level < 8; ++level)
+        {
+            EXPECT_EQ(intervals(intersection(lca_1, lca_2).on(level)), intervals(intersection(lca_1, lca_2, lca_2).on(level)));
+            EXPECT_EQ(intervals(union_(lca_1, lca_2).on(level)), intervals(union_(lca_1, lca_2, lca_2).on(level)));
+            EXPECT_EQ(intervals(difference(lca_1, lca_2).on(level)), intervals(difference(lca_1, lca_2, lca_2).on(level)));
+            EXPECT_EQ(intervals(difference(lca_2, translate(lca_1, stencil)).on(level)),
+                      intervals(difference(lca_2, translate(lca_1, stencil), translate(lca_1, stencil)).on(level)));
+        }
+        EXPECT_FALSE(intervals(difference(lca_2, lca_1).on(6)).empty());
+    }
+
+    TEST(subset, reduced_operands)
+    {
+        constexpr std::size_t dim = 2;
+        using lca_t               = LevelCellArray<dim>;
+        using interval_t          = typename lca_t::interval_t;
+
+        LevelCellList<dim> lcl{5};
+        for (int y = 0; y < 32; ++y)
+        {
+            lcl[{y}].add_interval({-y % 5, 3 + y % 7});
+            lcl[{y}].add_interval({8 + y % 3, 20});
+        }
+        const lca_t lca(lcl);
+        const lca_t copy(lcl);
+        const lca_t empty(6);
+
+        auto intervals = [](auto&& set)
+        {
+            std::vector<std::pair<interval_t, int>> output;
+            set(
+                [&](const auto& i, const auto& index)
+                {
+                    output.emplace_back(interval_t{i.start, i.end}, index[0]);
+                });
+            return output;
+        };
+
+        // an operand repeated or with empty sets is read once: the result is
+        // the same as with distinct operands
+        for (std::size_t level = 3; level < 7; ++level)
+        {
+            EXPECT_EQ(intervals(intersection(lca, lca).on(level)), intervals(intersection(lca, copy).on(level)));
+            EXPECT_EQ(intervals(union_(lca, lca).on(level)), intervals(union_(lca, copy).on(level)));
+            EXPECT_EQ(intervals(union_(empty, lca).on(level)), intervals(union_(empty, lca, empty).on(level)));
+            EXPECT_EQ(intervals(difference(lca, empty).on(level)), intervals(difference(lca, empty, empty).on(level)));
+            EXPECT_EQ(intervals(difference(lca, lca).on(level)), intervals(difference(lca, copy).on(level)));
+        }
+        EXPECT_TRUE(difference(lca, lca).empty());
+        EXPECT_TRUE(difference(lca, lca).on(6).empty());
+        EXPECT_FALSE(intersection(lca, lca).on(4).empty());
+    }
+
+    TEST(subset, to_level_cell_array)
+    {
+        constexpr std::size_t dim = 2;
+        using lca_t               = LevelCellArray<dim>;
+
+        LevelCellList<dim> lcl_1{5};
+        LevelCellList<dim> lcl_2{6};
+        for (int y = 0; y < 32; ++y)
+        {
+            lcl_1[{y}].add_interval({-y % 5, 3 + y % 7});
+            lcl_1[{y}].add_interval({8 + y % 3, 20});
+            lcl_2[{2 * y + 1}].add_interval({10 + y % 9, 16 + y % 13});
+        }
+        const lca_t lca_1(lcl_1);
+        const lca_t lca_2(lcl_2);
+
+        // on a coarser level the intervals given by the subset may be adjacent:
+        // they must be merged as in a LevelCellList
+        for (std::size_t level = 2; level < 8; ++level)
+        {
+            LevelCellList<dim> lcl{level};
+            union_(lca_1, lca_2)
+                .on(level)(
+                    [&](const auto& i, const auto& index)
+                    {
+                        lcl[index].add_interval(i);
+                    });
+            EXPECT_EQ(lca_t(union_(lca_1, lca_2).on(level)), lca_t(lcl));
+        }
+    }
+
+    TEST(subset, apply_rows)
+    {
+        constexpr std::size_t dim = 2;
+        using lca_t               = LevelCellArray<dim>;
+        using interval_t          = typename lca_t::interval_t;
+
+        LevelCellList<dim> lcl{5};
+        for (int y = 0; y < 32; ++y)
+        {
+            lcl[{y}].add_interval({-y % 5, 3 + y % 7});
+            lcl[{y}].add_interval({8 + y % 3, 20});
+        }
+        const lca_t lca(lcl);
+        xt::xtensor_fixed<int, xt::xshape<dim>> stencil{1, 1};
+
+        std::vector<std::pair<interval_t, int>> expected;
+        difference(lca, translate(lca, stencil))
+            .on(4)(
+                [&](const auto& i, const auto& index)
+                {
+                    expected.emplace_back(i, index[0]);
+                });
+
+        std::vector<std::pair<interval_t, int>> intervals;
+        std::vector<int> rows;
+        apply_rows(difference(lca, translate(lca, stencil)).on(4),
+                   [&](std::span<const interval_t> row, const auto& index)
+                   {
+                       EXPECT_FALSE(row.empty());
+                       rows.push_back(index[0]);
+                       for (const auto& i : row)
+                       {
+                           intervals.emplace_back(i, index[0]);
+                       }
+                   });
+
+        EXPECT_EQ(intervals, expected);
+        // one call per row
+        EXPECT_TRUE(std::adjacent_find(rows.cbegin(), rows.cend()) == rows.cend());
+
+        // the rows traversed concurrently are the same, each one being written by a single thread
+        constexpr int offset = 8;
+        std::vector<std::vector<interval_t>> parallel_rows(64);
+        apply_rows<Run::Parallel>(difference(lca, translate(lca, stencil)).on(4),
+                                  [&](std::span<const interval_t> row, const auto& index)
+                                  {
+                                      auto& parallel_row = parallel_rows[static_cast<std::size_t>(index[0] + offset)];
+                                      EXPECT_TRUE(parallel_row.empty());
+                                      parallel_row.assign(row.begin(), row.end());
+                                  });
+        std::vector<std::pair<interval_t, int>> parallel_intervals;
+        for (std::size_t r = 0; r < parallel_rows.size(); ++r)
+        {
+            for (const auto& i : parallel_rows[r])
+            {
+                parallel_intervals.emplace_back(i, static_cast<int>(r) - offset);
+            }
+        }
+        EXPECT_EQ(parallel_intervals, expected);
+    }
+
+    TEST(subset, bounding_box)
+    {
+        constexpr std::size_t dim = 2;
+        using lca_t               = LevelCellArray<dim>;
+
+        lca_t lca_1(4);
+        lca_1.add_interval_back({0, 4}, {0});
+        lca_1.add_interval_back({2, 6}, {1});
+        EXPECT_EQ(lca_1.min_indices(), (std::array<int, dim>{0, 0}));
+        EXPECT_EQ(lca_1.max_indices(), (std::array<int, dim>{6, 2}));
+
+        // the cached bounds follow the modifications
+        lca_1.add_interval_back({1, 9}, {3});
+        EXPECT_EQ(lca_1.max_indices(), (std::array<int, dim>{9, 4}));
+
+        lca_t lca_2(4);
+        lca_2.add_interval_back({12, 16}, {0});
+
+        EXPECT_TRUE(intersection(lca_1, lca_2).bounding_box().empty());
+        EXPECT_TRUE(intersection(lca_1, lca_2).empty());
+
+        xt::xtensor_fixed<int, xt::xshape<dim>> stencil{-8, 0};
+        EXPECT_FALSE(intersection(lca_1, translate(lca_2, stencil)).bounding_box().empty());
+        EXPECT_FALSE(intersection(lca_1, translate(lca_2, stencil)).empty());
+
+        // the boxes do not overlap, the projections on a coarser level do
+        EXPECT_FALSE(intersection(lca_1, lca_2).on(0).bounding_box().empty());
+        EXPECT_FALSE(intersection(lca_1, lca_2).on(0).empty());
+
+        // the cached bounds follow the modifications through the mutable iterators
+        lca_t lca_3(4);
+        lca_3.add_interval_back({12, 16}, {0});
+        EXPECT_TRUE(intersection(lca_1, lca_3).empty());
+
+        auto it   = lca_3.begin();
+        it->start = 2;
+        EXPECT_FALSE(intersection(lca_1, lca_3).empty());
+
+        for_each_interval(lca_3,
+                          [](auto, auto& interval, auto)
+                          {
+                              interval.start = 2;
+                              interval.end   = 6;
+                          });
+        std::size_t nb_cells = 0;
+        intersection(lca_1, lca_3)(
+            [&](const auto& interval, auto)
+            {
+                nb_cells += interval.size();
+            });
+        EXPECT_EQ(nb_cells, std::size_t{2});
+    }
+
+    TEST(subset, count_cells)
+    {
+        constexpr std::size_t dim = 2;
+        using lca_t               = LevelCellArray<dim>;
+
+        LevelCellList<dim> lcl{5};
+        for (int y = 0; y < 32; ++y)
+        {
+            lcl[{y}].add_interval({-y % 5, 3 + y % 7});
+            lcl[{y}].add_interval({8 + y % 3, 20});
+        }
+        const lca_t lca(lcl);
+        xt::xtensor_fixed<int, xt::xshape<dim>> stencil{1, 1};
+
+        for (std::size_t level = 3; level < 6; ++level)
+        {
+            auto set = difference(lca, translate(lca, stencil)).on(level);
+
+            std::size_t nb_cells     = 0;
+            std::size_t nb_intervals = 0;
+            set(
+                [&](const auto& i, const auto&)
+                {
+                    nb_cells += static_cast<std::size_t>(i.size());
+                    ++nb_intervals;
+                });
+
+            EXPECT_EQ(set.count_cells(), nb_cells);
+            EXPECT_EQ(set.count_intervals(), nb_intervals);
+
+            // early exit
+            EXPECT_EQ(set.count_intervals(2), 2u);
+            EXPECT_GE(set.count_cells(2), 2u);
+            EXPECT_LE(set.count_cells(2), nb_cells);
+        }
+
+        EXPECT_EQ(count_cells(intersection(lca, translate(lca, stencil))), lca_t(intersection(lca, translate(lca, stencil))).nb_cells());
+        EXPECT_EQ(translate(lca, stencil).on(5).count_cells(), lca.nb_cells());
+    }
+
+    TEST(subset, expand_contract)
+    {
+        constexpr std::size_t dim = 2;
+        using lca_t               = LevelCellArray<dim>;
+        using direction_t         = xt::xtensor_fixed<int, xt::xshape<dim>>;
+
+        LevelCellList<dim> lcl{5};
+        for (int y = 0; y < 32; ++y)
+        {
+            lcl[{y}].add_interval({-y % 5, 3 + y % 7});
+            lcl[{y}].add_interval({8 + y % 3, 20});
+        }
+        const lca_t lca(lcl);
+
+        // reference: a cell is in the expanded (resp. contracted) set if one (resp. all) of
+        // the cells at a distance of at most width along the selected directions is in the set
+        auto reference = [&](int width, const std::array<bool, dim>& directions, bool all)
+        {
+            auto in_lca = [&](int i, int j)
+            {
+                return find(lca, direction_t{i, j}) != -1;
+            };
+            const int wx = directions[0] ? width : 0;
+            const int wy = directions[1] ? width : 0;
+            LevelCellList<dim> ref{5};
+            for (int j = -8; j < 40; ++j)
+            {
+                for (int i = -16; i < 32; ++i)
+                {
+                    bool found = all;
+                    for (int dj = -wy; dj <= wy; ++dj)
+                    {
+                        for (int di = -wx; di <= wx; ++di)
+                        {
+                            found = all ? (found && in_lca(i - di, j - dj)) : (found || in_lca(i - di, j - dj));
+                        }
+                    }
+                    if (found)
+                    {
+                        ref[{j}].add_point(i);
+                    }
+                }
+            }
+            return lca_t(ref);
+        };
+
+        EXPECT_EQ(lca_t(expand(lca, 1)), lca_t(nestedExpand(lca, 1)));
+        for (int width : {1, 2, 3, 5})
+        {
+            const auto w = static_cast<std::size_t>(width);
+            for (const std::array<bool, dim>& directions : {std::array<bool, dim>{true, true},
+                                                            std::array<bool, dim>{true, false},
+                                                            std::array<bool, dim>{false, true}})
+            {
+                EXPECT_EQ(lca_t(expand(lca, w, directions)), reference(width, directions, false));
+                EXPECT_EQ(lca_t(contract(lca, w, directions)), reference(width, directions, true));
+            }
+            // the operand is computed once when it is not a LevelCellArray
+            const lca_t coarse(intersection(lca, lca).on(4));
+            EXPECT_EQ(lca_t(expand(self(lca).on(4), w)), lca_t(expand(coarse, w)));
+            EXPECT_EQ(lca_t(contract(self(lca).on(4), w)), lca_t(contract(coarse, w)));
+            EXPECT_EQ(lca_t(intersection(expand(lca, w), lca)), lca);
+        }
+
+        // the intervals emptied by the contraction are dropped, the ones which overlap once expanded are merged
+        lca_t row(5);
+        row.add_interval_back({0, 1}, {0});
+        row.add_interval_back({3, 10}, {0});
+        row.add_interval_back({12, 14}, {0});
+
+        lca_t contracted(5);
+        contracted.add_interval_back({5, 8}, {0});
+        EXPECT_EQ(lca_t(contract(row, 2, {true, false})), contracted);
+
+        lca_t expanded(5);
+        expanded.add_interval_back({-2, 16}, {0});
+        EXPECT_EQ(lca_t(expand(row, 2, {true, false})), expanded);
+
+        // box in 3D
+        using lca3_t = LevelCellArray<3>;
+        using box3_t = Box<int, 3>;
+        const lca3_t cube(4, box3_t{{0, 0, 0}, {6, 6, 6}});
+        EXPECT_EQ(lca3_t(expand(cube, 2)), lca3_t(4, box3_t{{-2, -2, -2}, {8, 8, 8}}));
+        EXPECT_EQ(lca3_t(contract(cube, 2)), lca3_t(4, box3_t{{2, 2, 2}, {4, 4, 4}}));
+        EXPECT_EQ(lca3_t(contract(cube, 2, {false, false, true})), lca3_t(4, box3_t{{0, 0, 2}, {6, 6, 4}}));
+        EXPECT_TRUE(lca3_t(contract(cube, 3)).empty());
+    }
 }